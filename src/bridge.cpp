@@ -1,4 +1,12 @@
 #include "bridge.h"
+#include "lua_allocator.h"
+#include "lua_bind_native.h"
+#include "lua_callable.h"
+#include "lua_chunk_cache.h"
+#include "lua_table.h"
+#include "lua_log.h"
+#include "lua_packed_arrays.h"
+#include "lua_value_types.h"
 #include <godot_cpp/classes/json.hpp>
 #include <godot_cpp/classes/window.hpp>
 #include <godot_cpp/core/class_db.hpp>
@@ -14,6 +22,12 @@
 #include <godot_cpp/classes/main_loop.hpp>
 #include <godot_cpp/classes/script.hpp>
 #include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/classes/global_constants.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <unordered_map>
 
 // Lua includes
 extern "C" {
@@ -24,19 +38,73 @@ extern "C" {
 
 using namespace godot;
 
-// Forward declarations for static helper functions
-static int lua_method_wrapper(lua_State *L);
-
-// Move ResourceUserData struct to file scope
-struct ResourceUserData {
-	Object* obj_ptr;
+// Payload of every GodotObject userdata. Objects are resolved by instance id through
+// ObjectDB, so a freed Node is detected instead of dereferenced; Resources
+// additionally hold a strong reference so Lua keeps them alive.
+struct GodotObjectUserData {
+	uint64_t instance_id = 0;
+	uint64_t script_id = 0;  // Script the attached method table was chosen for, 0 for none
 	Ref<Resource> resource_ref;
 };
 
-// Add size/alignment check
-static_assert(sizeof(ResourceUserData) == sizeof(Object*) + sizeof(Ref<Resource>), "ResourceUserData size mismatch");
-static_assert(alignof(ResourceUserData) >= alignof(Object*), "ResourceUserData alignment issue with Object*");
-static_assert(alignof(ResourceUserData) >= alignof(Ref<Resource>), "ResourceUserData alignment issue with Ref<Resource>");
+// Payload of GodotDictionary / GodotArray proxies. Dictionary and Array are reference
+// types, so the proxy shares the container with Godot rather than copying it.
+struct GodotContainerUserData {
+	Variant container;
+};
+
+// Call signature of a bound Godot method, resolved once per (class, method) and
+// stored as a full userdata upvalue of the method closure
+struct BoundMethodInfo {
+	StringName name;
+	std::vector<Variant::Type> arg_types;
+	Variant::Type return_type = Variant::NIL;
+	bool is_vararg = true;  // Also for methods that could not be resolved, so no arity check applies
+};
+
+// State of one lua_to_godot call. Tables already converted map to their Godot
+// container so shared sub-tables stay shared; a NIL entry marks a table that is
+// still being converted, which means a reference cycle.
+struct LuaConversionContext {
+	std::unordered_map<const void*, Variant> tables;
+	int depth = 0;
+	int64_t elements = 0;
+	String error;
+
+	bool failed() const { return !error.is_empty(); }
+};
+
+// Payload of the GodotCallable userdata bound as upvalue of each registered function,
+// so a call reaches its Callable without looking the name up
+struct RegisteredFunction {
+	Variant callable;  // Kept as a Variant so it can be invoked through Variant::callp
+	StringName call_method;
+	String name;
+	std::vector<Variant::Type> arg_types;
+	bool has_signature = false;
+};
+
+// Upper bound for arguments marshalled on the C stack; longer calls keep them on the heap
+static const int MAX_FAST_CALL_ARGS = 16;
+
+// Argument storage for one Godot call, on the C stack unless the call is unusually long
+struct CallArguments {
+	Variant stack_argv[MAX_FAST_CALL_ARGS];
+	const Variant* stack_argp[MAX_FAST_CALL_ARGS];
+	std::vector<Variant> heap_argv;
+	std::vector<const Variant*> heap_argp;
+	Variant* argv = stack_argv;
+	const Variant** argp = stack_argp;
+
+	explicit CallArguments(int argc) {
+		if (argc > MAX_FAST_CALL_ARGS) {
+			heap_argv.resize(argc);
+			heap_argp.resize(argc);
+			argv = heap_argv.data();
+			argp = heap_argp.data();
+		}
+	}
+};
 
 // Add at the top of the file, after includes
 // static std::vector<Ref<Resource>> g_resource_registry;
@@ -44,33 +112,51 @@ static_assert(alignof(ResourceUserData) >= alignof(Ref<Resource>), "ResourceUser
 // Add stack dump function
 void dump_lua_stack(lua_State* L) {
 	int top = lua_gettop(L);
-	UtilityFunctions::print("[LuaBridge] Stack dump - top: " + String::num_int64(top));
+	LUA_LOG_DEBUG(LuaLog::default_filter, LUA_LOG_BRIDGE, "Stack dump - top: " + String::num_int64(top));
 	for (int i = 1; i <= top; ++i) {
 		int t = lua_type(L, i);
 		const char* type_name = lua_typename(L, t);
-		UtilityFunctions::print("[LuaBridge] Stack[" + String::num_int64(i) + "]: " + String(type_name));
+		LUA_LOG_DEBUG(LuaLog::default_filter, LUA_LOG_BRIDGE, "Stack[" + String::num_int64(i) + "]: " + String(type_name));
 	}
 }
 
 
 extern "C" int lua_test_return_42(lua_State* L) {
-    UtilityFunctions::print("[LuaBridge] lua_test_return_42 called (with Lua C API)");
+    LUA_LOG_DEBUG(LuaLog::default_filter, LUA_LOG_BRIDGE, "lua_test_return_42 called (with Lua C API)");
     lua_pushinteger(L, 42);
     dump_lua_stack(L);
-    UtilityFunctions::print("[LuaBridge] About to return from lua_test_return_42");
+    LUA_LOG_DEBUG(LuaLog::default_filter, LUA_LOG_BRIDGE, "About to return from lua_test_return_42");
     return 1;
 }
 
+// luaL_newstate installs a panic handler; states built on the pooled allocator need their own
+static int lua_bridge_panic(lua_State* L) {
+	const char* message = lua_tostring(L, -1);
+	LUA_LOG_ERROR(LuaLog::default_filter, LUA_LOG_BRIDGE, "Unprotected Lua error: " + String(message ? message : "(error object is not a string)"));
+	return 0; // abort
+}
+
 void LuaBridge::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("exec_string", "code"), &LuaBridge::exec_string);
 	ClassDB::bind_method(D_METHOD("load_file", "path"), &LuaBridge::load_file);
 	ClassDB::bind_method(D_METHOD("unload"), &LuaBridge::unload);
+	ClassDB::bind_method(D_METHOD("set_bytecode_cache_enabled", "enabled"), &LuaBridge::set_bytecode_cache_enabled);
+	ClassDB::bind_method(D_METHOD("is_bytecode_cache_enabled"), &LuaBridge::is_bytecode_cache_enabled);
+	ClassDB::bind_method(D_METHOD("clear_bytecode_cache"), &LuaBridge::clear_bytecode_cache);
+	ClassDB::bind_method(D_METHOD("get_bytecode_cache_stats"), &LuaBridge::get_bytecode_cache_stats);
 	
 	ClassDB::bind_method(D_METHOD("set_global", "name", "value"), &LuaBridge::set_global);
 	ClassDB::bind_method(D_METHOD("get_global", "name"), &LuaBridge::get_global);
 	
 	ClassDB::bind_method(D_METHOD("call_function", "func_name", "args"), &LuaBridge::call_function);
 	ClassDB::bind_method(D_METHOD("register_function", "name", "cb"), &LuaBridge::register_function);
+	ClassDB::bind_method(D_METHOD("register_function_with_signature", "name", "cb", "arg_types"), &LuaBridge::register_function_with_signature);
+	
+	// Pre-resolved function handles
+	ClassDB::bind_method(D_METHOD("resolve_function", "func_name"), &LuaBridge::resolve_function);
+	ClassDB::bind_method(D_METHOD("call_handle", "handle", "args"), &LuaBridge::call_handle);
+	ClassDB::bind_method(D_METHOD("release_handle", "handle"), &LuaBridge::release_handle);
+	ClassDB::bind_method(D_METHOD("is_handle_valid", "handle"), &LuaBridge::is_handle_valid);
 	
 	// Object access
 	ClassDB::bind_method(D_METHOD("get_property", "obj", "property_name"), &LuaBridge::get_property);
@@ -106,9 +192,53 @@ void LuaBridge::_bind_methods() {
 	// Verbose logging control
 	ClassDB::bind_method(D_METHOD("set_verbose_logging", "enabled"), &LuaBridge::set_verbose_logging);
 	ClassDB::bind_method(D_METHOD("is_verbose_logging"), &LuaBridge::is_verbose_logging);
+	ClassDB::bind_method(D_METHOD("set_log_buffering", "enabled"), &LuaBridge::set_log_buffering);
+	ClassDB::bind_method(D_METHOD("is_log_buffering"), &LuaBridge::is_log_buffering);
+	ClassDB::bind_method(D_METHOD("set_log_buffer_capacity", "capacity"), &LuaBridge::set_log_buffer_capacity);
+	ClassDB::bind_method(D_METHOD("get_log_buffer_capacity"), &LuaBridge::get_log_buffer_capacity);
+	ClassDB::bind_method(D_METHOD("get_dropped_log_count"), &LuaBridge::get_dropped_log_count);
+	ClassDB::bind_method(D_METHOD("flush_logs"), &LuaBridge::flush_logs);
+	ClassDB::bind_method(D_METHOD("set_log_categories", "categories"), &LuaBridge::set_log_categories);
+	ClassDB::bind_method(D_METHOD("get_log_categories"), &LuaBridge::get_log_categories);
+	ClassDB::bind_integer_constant(get_class_static(), "LogCategory", "LOG_BRIDGE", LUA_LOG_BRIDGE, true);
+	ClassDB::bind_integer_constant(get_class_static(), "LogCategory", "LOG_CONVERSION", LUA_LOG_CONVERSION, true);
+	ClassDB::bind_integer_constant(get_class_static(), "LogCategory", "LOG_GC", LUA_LOG_GC, true);
+	ClassDB::bind_integer_constant(get_class_static(), "LogCategory", "LOG_MODS", LUA_LOG_MODS, true);
+	ClassDB::bind_integer_constant(get_class_static(), "LogCategory", "LOG_RESOURCES", LUA_LOG_RESOURCES, true);
+	ClassDB::bind_integer_constant(get_class_static(), "LogCategory", "LOG_ALL", LUA_LOG_ALL, true);
+
+	// Conversion limits
+	ClassDB::bind_method(D_METHOD("set_conversion_max_depth", "depth"), &LuaBridge::set_conversion_max_depth);
+	ClassDB::bind_method(D_METHOD("get_conversion_max_depth"), &LuaBridge::get_conversion_max_depth);
+	ClassDB::bind_method(D_METHOD("set_conversion_max_elements", "max_elements"), &LuaBridge::set_conversion_max_elements);
+	ClassDB::bind_method(D_METHOD("get_conversion_max_elements"), &LuaBridge::get_conversion_max_elements);
+	ClassDB::bind_method(D_METHOD("set_table_proxies_enabled", "enabled"), &LuaBridge::set_table_proxies_enabled);
+	ClassDB::bind_method(D_METHOD("is_table_proxies_enabled"), &LuaBridge::is_table_proxies_enabled);
+	ClassDB::bind_method(D_METHOD("set_container_proxies_enabled", "enabled"), &LuaBridge::set_container_proxies_enabled);
+	ClassDB::bind_method(D_METHOD("is_container_proxies_enabled"), &LuaBridge::is_container_proxies_enabled);
+
+	// Memory
+	ClassDB::bind_method(D_METHOD("get_memory_stats"), &LuaBridge::get_memory_stats);
+	ClassDB::bind_method(D_METHOD("get_mod_memory_usage", "mod_name"), &LuaBridge::get_mod_memory_usage);
+	ClassDB::bind_method(D_METHOD("set_memory_limits_enforced", "enforced"), &LuaBridge::set_memory_limits_enforced);
+	ClassDB::bind_method(D_METHOD("is_memory_limits_enforced"), &LuaBridge::is_memory_limits_enforced);
+
+	// Garbage collection
+	ClassDB::bind_method(D_METHOD("set_gc_frame_budget", "usec"), &LuaBridge::set_gc_frame_budget);
+	ClassDB::bind_method(D_METHOD("get_gc_frame_budget"), &LuaBridge::get_gc_frame_budget);
+	ClassDB::bind_method(D_METHOD("set_gc_mode", "mode"), &LuaBridge::set_gc_mode);
+	ClassDB::bind_method(D_METHOD("get_gc_mode"), &LuaBridge::get_gc_mode);
+	ClassDB::bind_method(D_METHOD("set_gc_adaptive", "enabled"), &LuaBridge::set_gc_adaptive);
+	ClassDB::bind_method(D_METHOD("is_gc_adaptive"), &LuaBridge::is_gc_adaptive);
+	ClassDB::bind_method(D_METHOD("set_gc_target_frame_fraction", "fraction"), &LuaBridge::set_gc_target_frame_fraction);
+	ClassDB::bind_method(D_METHOD("get_gc_target_frame_fraction"), &LuaBridge::get_gc_target_frame_fraction);
+	ClassDB::bind_method(D_METHOD("get_gc_stats"), &LuaBridge::get_gc_stats);
+	ClassDB::bind_integer_constant(get_class_static(), "GCMode", "GC_INCREMENTAL", GC_INCREMENTAL, false);
+	ClassDB::bind_integer_constant(get_class_static(), "GCMode", "GC_GENERATIONAL", GC_GENERATIONAL, false);
 
 	// Signals
 	ADD_SIGNAL(MethodInfo("lua_error_occurred", PropertyInfo(Variant::STRING, "error_message"), PropertyInfo(Variant::STRING, "error_type"), PropertyInfo(Variant::STRING, "file_path")));
+	ADD_SIGNAL(MethodInfo("mod_over_budget", PropertyInfo(Variant::STRING, "mod_name"), PropertyInfo(Variant::INT, "bytes_in_use"), PropertyInfo(Variant::INT, "memory_limit")));
 
 	// Mod management
 	ClassDB::bind_method(D_METHOD("load_mods_from_directory", "mods_dir"), &LuaBridge::load_mods_from_directory);
@@ -150,66 +280,78 @@ void LuaBridge::_bind_methods() {
 }
 
 LuaBridge::LuaBridge() {
-	L = luaL_newstate();
-	if (L) {
-		if (sandboxed) {
-			setup_safe_environment();
-		} else {
-			luaL_openlibs(L);
-		}
-		setup_godot_object_metatable();
-		setup_game_api();
-		setup_require_handler();
-
-		// In the LuaBridge initialization, after setting up the Lua state, register the function:
-		lua_register(L, "test_return_42", lua_test_return_42);
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Registered test_return_42");
-		}
+	init_lua_state();
+}
 
-		// In LuaBridge constructor, after initializing L:
-		lua_pushlightuserdata(L, this);
-		lua_setfield(L, LUA_REGISTRYINDEX, "godot_lua_bridge_ptr");
+LuaBridge::LuaBridge(bool verbose) {
+	if (verbose) {
+		log_filter.level = LUA_LOG_LEVEL_DEBUG;
 	}
+	init_lua_state();
 }
 
-LuaBridge::LuaBridge(bool verbose) : verbose_logging(verbose) {
-	L = luaL_newstate();
-	if (L) {
-		if (sandboxed) {
-			setup_safe_environment();
-		} else {
-			luaL_openlibs(L);
-		}
-		setup_godot_object_metatable();
-		setup_game_api();
-		setup_require_handler();
+void LuaBridge::init_lua_state() {
+	allocator = new LuaAllocator();
+	allocator->set_limits_enforced(memory_limits_enforced);
+	L = lua_newstate(LuaAllocator::lua_alloc, allocator);
+	if (!L) {
+		LUA_LOG_ERROR(log_filter, LUA_LOG_BRIDGE, "Failed to create Lua state");
+		delete allocator;
+		allocator = nullptr;
+		return;
+	}
+	// luaL_newstate would install both handlers; lua_newstate installs neither
+	lua_atpanic(L, lua_bridge_panic);
+	lua_setwarnf(L, lua_warning, this);
+	if (sandboxed) {
+		setup_safe_environment();
+	} else {
+		luaL_openlibs(L);
+	}
+	setup_godot_object_metatable();
+	setup_game_api();
+	setup_require_handler();
 
-		// In the LuaBridge initialization, after setting up the Lua state, register the function:
-		lua_register(L, "test_return_42", lua_test_return_42);
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Registered test_return_42");
-		}
+	// In the LuaBridge initialization, after setting up the Lua state, register the function:
+	lua_register(L, "test_return_42", lua_test_return_42);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Registered test_return_42");
 
-		// In LuaBridge constructor, after initializing L:
-		lua_pushlightuserdata(L, this);
-		lua_setfield(L, LUA_REGISTRYINDEX, "godot_lua_bridge_ptr");
+	// In LuaBridge constructor, after initializing L:
+	lua_pushlightuserdata(L, this);
+	lua_setfield(L, LUA_REGISTRYINDEX, "godot_lua_bridge_ptr");
+}
+
+// Lua's warn() and the "error in __gc" warnings. Messages may arrive in pieces (tocont
+// set on all but the last); a single-piece message starting with '@' is a control message.
+void LuaBridge::lua_warning(void* ud, const char* message, int tocont) {
+	LuaBridge* bridge = static_cast<LuaBridge*>(ud);
+	if (bridge->pending_lua_warning.is_empty() && !tocont && message[0] == '@') {
+		if (strcmp(message, "@off") == 0) {
+			bridge->lua_warnings_enabled = false;
+		} else if (strcmp(message, "@on") == 0) {
+			bridge->lua_warnings_enabled = true;
+		}
+		return;
+	}
+	bridge->pending_lua_warning += String::utf8(message);
+	if (tocont) {
+		return;
 	}
+	if (bridge->lua_warnings_enabled) {
+		LUA_LOG_WARN(bridge->log_filter, LUA_LOG_BRIDGE, "Lua warning: " + bridge->pending_lua_warning);
+	}
+	bridge->pending_lua_warning = String();
 }
 
 LuaBridge::~LuaBridge() {
 	if (L) {
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Destructor called, cleaning up...");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Destructor called, cleaning up...");
 		
 		// Set cleanup flag to prevent __gc from accessing bridge during cleanup
 		is_cleaning_up = true;
 		
 		// Clear all global references first to prevent use-after-free
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Clearing global references...");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Clearing global references...");
 		
 		// Clear event subscribers to prevent callbacks after cleanup
 		event_subscribers.clear();
@@ -217,79 +359,206 @@ LuaBridge::~LuaBridge() {
 		// Clear coroutines to prevent them from running after cleanup
 		coroutine_active.clear();
 		
+		// Function handles point into the registry that is about to be closed
+		function_handles.clear();
+		
 		// Clear wrapper objects map to prevent cleanup issues
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Clearing wrapper objects map...");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Clearing wrapper objects map...");
 		wrapper_objects.clear();
 		object_wrappers.clear();
 		
 		// Force garbage collection to clean up all wrapped objects
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Running garbage collection...");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Running garbage collection...");
 		lua_gc(L, LUA_GCCOLLECT, 0);
 		
 		// Wait a moment for GC to complete
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Garbage collection completed");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Garbage collection completed");
 		
 		// NOW clear the registry pointer after GC is complete
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Clearing registry pointer...");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Clearing registry pointer...");
 		lua_pushnil(L);
 		lua_setfield(L, LUA_REGISTRYINDEX, "godot_lua_bridge_ptr");
 		
 		// Close the Lua state
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Closing Lua state...");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Closing Lua state...");
 		lua_close(L);
 		L = nullptr;
+		delete allocator;
+		allocator = nullptr;
+		mod_memory_owners.clear();
+		module_path_cache.clear();
 		
-		if (verbose_logging) {
-			UtilityFunctions::print("[LuaBridge] Destructor cleanup completed");
-		}
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Destructor cleanup completed");
 	}
 }
 
 void LuaBridge::setup_require_handler() {
 	if (!L) return;
+	lua_newtable(L);
+	lua_setfield(L, LUA_REGISTRYINDEX, "godot_module_cache");
 	lua_pushlightuserdata(L, this);
 	lua_pushcclosure(L, lua_require_mod, 1);
 	lua_setglobal(L, "require");
 }
 
+// Marks a module whose chunk is still running, to catch require() cycles
+static char module_loading_sentinel;
+
 int LuaBridge::lua_require_mod(lua_State* L) {
 	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
 	if (!bridge) {
-		lua_pushstring(L, "[LuaBridge] require: No bridge context");
-		lua_error(L);
-		return 1;
+		return luaL_error(L, "[LuaBridge] require: No bridge context");
 	}
 	const char* modname = luaL_checkstring(L, 1);
-	String modfile = "mods/" + String(modname) + ".lua";
-	if (!FileAccess::file_exists(modfile)) {
-		lua_pushfstring(L, "[LuaBridge] require: Module not found: %s", modfile.utf8().get_data());
-		lua_error(L);
-		return 1;
+	lua_settop(L, 1);
+
+	// C++ locals live in their own scopes: luaL_error longjmps past any still alive.
+	// Pushing the path can still fail for lack of memory while they are alive.
+	bool found = false;
+	{
+		String path = bridge->resolve_module_path(L, String::utf8(modname));
+		if (!path.is_empty()) {
+			CharString utf8 = path.utf8();
+			lua_pushlstring(L, utf8.get_data(), utf8.length());
+			found = true;
+		}
 	}
-	Ref<FileAccess> file = FileAccess::open(modfile, FileAccess::READ);
-	String code = file->get_as_text();
-	file->close();
-	if (luaL_loadstring(L, code.utf8().get_data()) != LUA_OK) {
-		lua_pushfstring(L, "[LuaBridge] require: Load error: %s", lua_tostring(L, -1));
-		lua_error(L);
-		return 1;
+	if (!found) {
+		return luaL_error(L, "[LuaBridge] require: Module not found: %s", modname);
 	}
-	if (lua_pcall(L, 0, LUA_MULTRET, 0) != LUA_OK) {
-		// String error_msg = "Lua Runtime Error: " + get_lua_error();
-		// log_error(error_msg);
+	const int path_index = 2;
+
+	// Modules are cached per bridge by resolved path, the way package.loaded caches them by name,
+	// so two mods can each ship their own "utils"
+	lua_getfield(L, LUA_REGISTRYINDEX, "godot_module_cache");
+	const int cache_index = 3;
+	lua_pushvalue(L, path_index);
+	if (lua_rawget(L, cache_index) != LUA_TNIL) {
+		if (lua_touserdata(L, -1) == &module_loading_sentinel) {
+			return luaL_error(L, "[LuaBridge] require: Loop while loading module '%s'", modname);
+		}
 		return 1;
 	}
-	return 1;
+	lua_pop(L, 1);
+
+	lua_pushvalue(L, path_index);
+	lua_pushlightuserdata(L, &module_loading_sentinel);
+	lua_rawset(L, cache_index);
+
+	int status;
+	{
+		String path = String::utf8(lua_tostring(L, path_index));
+		// Chunk names use the same globalized form as load_file(), so module code is charged to its mod
+		String chunkname = "@" + ProjectSettings::get_singleton()->globalize_path(path);
+		status = LuaChunkCache::load_file(L, path, chunkname, bridge->bytecode_cache_enabled, &bridge->bytecode_cache_stats, bridge->log_filter);
+	}
+	if (status == LUA_OK) {
+		// Like Lua's require, the chunk receives the module name and where it was found
+		lua_pushvalue(L, 1);
+		lua_pushvalue(L, path_index);
+		status = lua_pcall(L, 2, 1, 0);
+	}
+	if (status != LUA_OK) {
+		// Forget the failed attempt so a fixed module can be required again
+		lua_pushvalue(L, path_index);
+		lua_pushnil(L);
+		lua_rawset(L, cache_index);
+		return luaL_error(L, "[LuaBridge] require: Error loading module '%s': %s", modname, lua_tostring(L, -1));
+	}
+
+	// A module that returns nothing is recorded as true, as in package.loaded
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1);
+		lua_pushboolean(L, 1);
+	}
+	lua_pushvalue(L, path_index);
+	lua_pushvalue(L, -2);
+	lua_rawset(L, cache_index);
+	lua_pushvalue(L, path_index);
+	return 2;
+}
+
+String LuaBridge::resolve_module_path(lua_State* L, const String& modname) {
+	// Modules are looked up next to the calling mod's scripts first. The caller is the
+	// nearest Lua function: C frames in between, such as pcall(require, ...), have no source.
+	String mod_name;
+	lua_Debug ar;
+	for (int level = 1; lua_getstack(L, level, &ar); level++) {
+		if (!lua_getinfo(L, "S", &ar) || strcmp(ar.what, "C") == 0) {
+			continue;
+		}
+		uint32_t owner = find_mod_memory_owner(ar.source);
+		if (owner != 0) {
+			mod_name = mod_memory_owners[owner - 1].mod_name;
+		}
+		break;
+	}
+
+	String key = mod_name + ":" + modname;
+	auto cached = module_path_cache.find(key);
+	if (cached != module_path_cache.end()) {
+		return cached->second;
+	}
+
+	PackedStringArray candidates;
+	auto mod = loaded_mods.find(mod_name);
+	if (mod != loaded_mods.end()) {
+		String mod_dir = mod->second.get("mod_dir", "");
+		String relative = modname.replace(".", "/");
+		candidates.append(mod_dir.path_join(relative + ".lua"));
+		candidates.append(mod_dir.path_join(relative).path_join("init.lua"));
+	}
+	candidates.append("mods/" + modname + ".lua");
+
+	for (int64_t i = 0; i < candidates.size(); i++) {
+		if (FileAccess::file_exists(candidates[i])) {
+			LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "require: Resolved " + modname + " to " + candidates[i]);
+			module_path_cache[key] = candidates[i];
+			return candidates[i];
+		}
+	}
+	// Misses are not memoized, so a module added later is still found
+	return String();
+}
+
+void LuaBridge::invalidate_module_cache(const String& mod_name, const String& mod_dir) {
+	// Modules are dropped by owning mod: everything under its directory, plus whatever it
+	// resolved elsewhere, such as a shared mods/<name>.lua fallback
+	std::set<String> resolved_paths;
+	String key_prefix = mod_name + ":";
+	for (auto it = module_path_cache.begin(); it != module_path_cache.end();) {
+		if (!it->first.begins_with(key_prefix)) {
+			++it;
+			continue;
+		}
+		resolved_paths.insert(it->second);
+		it = module_path_cache.erase(it);
+	}
+	if (!L) {
+		return;
+	}
+
+	String prefix = mod_dir.is_empty() ? String() : mod_dir.trim_suffix("/") + "/";
+	lua_getfield(L, LUA_REGISTRYINDEX, "godot_module_cache");
+	int cache_index = lua_gettop(L);
+	int removed = 0;
+	lua_pushnil(L);
+	while (lua_next(L, cache_index)) {
+		lua_pop(L, 1);
+		if (lua_type(L, -1) != LUA_TSTRING) {
+			continue;
+		}
+		String path = String::utf8(lua_tostring(L, -1));
+		if ((!prefix.is_empty() && path.begins_with(prefix)) || resolved_paths.count(path)) {
+			// Clearing an existing field is allowed during traversal
+			lua_pushvalue(L, -1);
+			lua_pushnil(L);
+			lua_rawset(L, cache_index);
+			removed++;
+		}
+	}
+	lua_pop(L, 1);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "require: Dropped " + String::num_int64(removed) + " cached modules of " + mod_name);
 }
 
 int LuaBridge::lua_class_constructor(lua_State* L) {
@@ -363,35 +632,44 @@ bool LuaBridge::load_file(String path) {
 		return false;
 	}
 
-	// Try to load the file with better error handling
-	int result = luaL_dofile(L, resolved_path.utf8().get_data());
+	// Compile through the bytecode cache. The chunk name keeps the path for error messages
+	// and for charging the script's allocations to its mod.
+	int top = lua_gettop(L);
+	int result = LuaChunkCache::load_file(L, resolved_path, "@" + resolved_path, bytecode_cache_enabled, &bytecode_cache_stats, log_filter);
+	if (result == LUA_OK) {
+		result = lua_pcall(L, 0, LUA_MULTRET, 0);
+	}
 	if (result != LUA_OK) {
 		String error_msg = "Lua File Error in " + path + ": " + get_lua_error();
 		log_lua_error(error_msg, "file_error", path);
+		lua_settop(L, top);
 		return false;
 	}
 
+	// Discard whatever the chunk returned
+	lua_settop(L, top);
 	return true;
 }
 
 void LuaBridge::unload() {
 	if (L) {
-		UtilityFunctions::print("[LuaBridge] Unload called, cleaning up...");
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Unload called, cleaning up...");
 		
 		// Set cleanup flag to prevent __gc from accessing bridge during cleanup
 		is_cleaning_up = true;
 		
 		// Clear wrapper objects map first to prevent cleanup issues
-		UtilityFunctions::print("[LuaBridge] Clearing wrapper objects map...");
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Clearing wrapper objects map...");
 		wrapper_objects.clear();
 		object_wrappers.clear();
 		
-		// Clear event subscribers and coroutines
+		// Clear event subscribers, coroutines and function handles
 		event_subscribers.clear();
 		coroutine_active.clear();
+		function_handles.clear();
 		
 		// Force garbage collection to clean up all wrapped objects
-		UtilityFunctions::print("[LuaBridge] Running garbage collection...");
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Running garbage collection...");
 		lua_gc(L, LUA_GCCOLLECT, 0);
 		
 		// NOW clear the registry pointer after GC is complete
@@ -399,10 +677,14 @@ void LuaBridge::unload() {
 		lua_setfield(L, LUA_REGISTRYINDEX, "godot_lua_bridge_ptr");
 		
 		// Close the Lua state
-		UtilityFunctions::print("[LuaBridge] Closing Lua state...");
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Closing Lua state...");
 		lua_close(L);
 		L = nullptr;
-		UtilityFunctions::print("[LuaBridge] Unload completed");
+		delete allocator;
+		allocator = nullptr;
+		mod_memory_owners.clear();
+		module_path_cache.clear();
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Unload completed");
 	}
 }
 
@@ -419,20 +701,17 @@ Variant LuaBridge::get_global(String name) const {
 	if (is_cleaning_up) return Variant();
 	
 	lua_getglobal(L, name.utf8().get_data());
-	Variant result = lua_to_godot(L, -1);
+	Variant result = table_proxies_enabled ? lua_to_godot_lazy(L, -1) : lua_to_godot(L, -1);
 	lua_pop(L, 1);
 	return result;
 }
 
-Variant LuaBridge::call_function(String func_name, Array args) {
-	if (!L) return Variant();
-	if (is_cleaning_up) return Variant();
-	
+bool LuaBridge::push_function_by_name(const String &func_name) {
 	// Split function name by dots to handle nested calls
 	PackedStringArray parts = func_name.split(".");
 	if (parts.size() == 0) {
 		log_error("Empty function name");
-		return Variant();
+		return false;
 	}
 	
 	// Get the base object
@@ -440,7 +719,7 @@ Variant LuaBridge::call_function(String func_name, Array args) {
 	if (lua_isnil(L, -1)) {
 		lua_pop(L, 1);
 		log_error("Function not found: " + func_name);
-		return Variant();
+		return false;
 	}
 	
 	// Navigate through nested tables
@@ -448,14 +727,14 @@ Variant LuaBridge::call_function(String func_name, Array args) {
 		if (!lua_istable(L, -1)) {
 			lua_pop(L, 1);
 			log_error("Not a table: " + parts[i]);
-			return Variant();
+			return false;
 		}
 		lua_getfield(L, -1, parts[i].utf8().get_data());
 		lua_remove(L, -2); // Remove the previous table
 		if (lua_isnil(L, -1)) {
 			lua_pop(L, 1);
 			log_error("Field not found: " + parts[i]);
-			return Variant();
+			return false;
 		}
 	}
 	
@@ -464,7 +743,7 @@ Variant LuaBridge::call_function(String func_name, Array args) {
 		if (!lua_istable(L, -1)) {
 			lua_pop(L, 1);
 			log_error("Not a table: " + parts[parts.size() - 2]);
-			return Variant();
+			return false;
 		}
 		lua_getfield(L, -1, parts[parts.size() - 1].utf8().get_data());
 		lua_remove(L, -2); // Remove the table
@@ -473,29 +752,124 @@ Variant LuaBridge::call_function(String func_name, Array args) {
 	if (!lua_isfunction(L, -1)) {
 		lua_pop(L, 1);
 		log_error("Not a function: " + func_name);
-		return Variant();
+		return false;
 	}
+	return true;
+}
 
+Variant LuaBridge::call_pushed_function(const String &func_name, const Array &args) {
 	// Push arguments
 	for (int i = 0; i < args.size(); i++) {
 		godot_to_lua(L, args[i]);
 	}
+	return pcall_pushed_function(func_name, args.size());
+}
+
+Variant LuaBridge::pcall_pushed_function(const String &func_name, int arg_count) {
+	// Charge the call's allocations to the mod that defined the function
+	uint32_t previous_owner = allocator->get_current_owner();
+	allocator->set_current_owner(get_function_memory_owner(-(arg_count + 1)));
 
 	// Call function with error handling
-	int result = lua_pcall(L, args.size(), 1, 0);
+	int result = lua_pcall(L, arg_count, 1, 0);
+	allocator->set_current_owner(previous_owner);
+	emit_memory_budget_events();
 	if (result != LUA_OK) {
 		String error_msg = "Lua Error in " + func_name + ": " + get_lua_error();
 		log_lua_error(error_msg, "function_call", "");
-		lua_pop(L, 1);
 		return Variant();
 	}
 
 	// Get return value
-	Variant return_value = lua_to_godot(L, -1);
+	Variant return_value = table_proxies_enabled ? lua_to_godot_lazy(L, -1) : lua_to_godot(L, -1);
 	lua_pop(L, 1);
 	return return_value;
 }
 
+Variant LuaBridge::call_function(String func_name, Array args) {
+	if (!L) return Variant();
+	if (is_cleaning_up) return Variant();
+	
+	if (!push_function_by_name(func_name)) {
+		return Variant();
+	}
+	return call_pushed_function(func_name, args);
+}
+
+int64_t LuaBridge::resolve_function(String func_name) {
+	if (!L) return 0;
+	if (is_cleaning_up) return 0;
+	
+	if (!push_function_by_name(func_name)) {
+		return 0;
+	}
+	
+	// Pin the function in the registry so later calls skip the name lookup
+	FunctionHandle handle;
+	lua_Debug ar;
+	lua_pushvalue(L, -1);
+	if (lua_getinfo(L, ">S", &ar) && ar.source[0] == '@') {
+		handle.source = String::utf8(ar.source);
+	}
+	handle.ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	handle.func_name = func_name;
+	
+	int64_t id = next_function_handle++;
+	function_handles[id] = handle;
+	return id;
+}
+
+Variant LuaBridge::call_handle(int64_t handle, Array args) {
+	if (!L) return Variant();
+	if (is_cleaning_up) return Variant();
+	
+	auto it = function_handles.find(handle);
+	if (it == function_handles.end()) {
+		log_error("Invalid function handle: " + String::num_int64(handle));
+		return Variant();
+	}
+	
+	lua_rawgeti(L, LUA_REGISTRYINDEX, it->second.ref);
+	return call_pushed_function(it->second.func_name, args);
+}
+
+void LuaBridge::release_handle(int64_t handle) {
+	auto it = function_handles.find(handle);
+	if (it == function_handles.end()) return;
+	
+	if (L) {
+		luaL_unref(L, LUA_REGISTRYINDEX, it->second.ref);
+	}
+	function_handles.erase(it);
+}
+
+bool LuaBridge::is_handle_valid(int64_t handle) const {
+	return function_handles.find(handle) != function_handles.end();
+}
+
+// Chunk name prefix shared by every script under a mod directory
+static String get_mod_source_prefix(const String& mod_dir) {
+	return "@" + ProjectSettings::get_singleton()->globalize_path(mod_dir).trim_suffix("/") + "/";
+}
+
+void LuaBridge::invalidate_function_handles(const String& mod_dir) {
+	if (mod_dir.is_empty()) {
+		return;
+	}
+	// Only functions defined under the mod go stale; handles into other mods stay valid
+	String prefix = get_mod_source_prefix(mod_dir);
+	for (auto it = function_handles.begin(); it != function_handles.end();) {
+		if (!it->second.source.begins_with(prefix)) {
+			++it;
+			continue;
+		}
+		if (L) {
+			luaL_unref(L, LUA_REGISTRYINDEX, it->second.ref);
+		}
+		it = function_handles.erase(it);
+	}
+}
+
 void LuaBridge::register_function(String name, Callable cb) {
 	if (!L) {
 		// log_error("Cannot register function: Lua state not initialized");
@@ -504,22 +878,65 @@ void LuaBridge::register_function(String name, Callable cb) {
 	
 	registered_functions[name] = cb;
 	
-	lua_pushlightuserdata(L, this);
-	lua_pushstring(L, name.utf8().get_data());
-	lua_pushcclosure(L, lua_call_godot_function, 2);
+	push_callable_closure(L, name, cb, nullptr);
 	lua_setglobal(L, name.utf8().get_data());
 	
-	print_to_console("Registered Godot function: " + name);
+	LUA_LOG_INFO(log_filter, LUA_LOG_BRIDGE, "Registered Godot function: " + name);
+}
+
+void LuaBridge::register_function_with_signature(String name, Callable cb, PackedInt32Array arg_types) {
+	if (!L) {
+		return;
+	}
+	// Typed signatures stay within the arguments marshalled on the C stack
+	if (arg_types.size() > MAX_FAST_CALL_ARGS) {
+		LUA_LOG_ERROR(log_filter, LUA_LOG_BRIDGE, "Cannot register " + name + ": " + String::num_int64(arg_types.size()) + " typed arguments, max " + String::num_int64(MAX_FAST_CALL_ARGS));
+		return;
+	}
+	
+	registered_functions[name] = cb;
+	
+	push_callable_closure(L, name, cb, &arg_types);
+	lua_setglobal(L, name.utf8().get_data());
+	
+	LUA_LOG_INFO(log_filter, LUA_LOG_BRIDGE, "Registered Godot function: " + name + " (" + String::num_int64(arg_types.size()) + " typed arguments)");
+}
+
+void LuaBridge::push_callable_closure(lua_State* L, const String& name, const Callable& callable, const PackedInt32Array* arg_types) {
+	lua_pushlightuserdata(L, this);
+	
+	RegisteredFunction* fn = static_cast<RegisteredFunction*>(lua_newuserdatauv(L, sizeof(RegisteredFunction), 0));
+	new (fn) RegisteredFunction();
+	fn->callable = callable;
+	fn->call_method = StringName("call");
+	fn->name = name;
+	if (arg_types) {
+		fn->has_signature = true;
+		for (int64_t i = 0; i < arg_types->size(); i++) {
+			fn->arg_types.push_back((Variant::Type)(*arg_types)[i]);
+		}
+	}
+	luaL_setmetatable(L, "GodotCallable");
+	
+	lua_pushcclosure(L, lua_call_godot_function, 2);
+}
+
+int LuaBridge::lua_registered_function_gc(lua_State* L) {
+	RegisteredFunction* fn = static_cast<RegisteredFunction*>(lua_touserdata(L, 1));
+	if (fn) {
+		fn->~RegisteredFunction();
+	}
+	return 0;
 }
 
 Variant LuaBridge::get_property(Variant obj, String property_name) const {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("get_property: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_property: Not a Godot object");
 		return Variant();
 	}
 	Object* object = Object::cast_to<Object>(obj.operator Object*());
 	if (!object) {
-		print_to_console("get_property: Invalid object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_property: Invalid object");
 		return Variant();
 	}
 	return object->get(property_name);
@@ -527,12 +944,12 @@ Variant LuaBridge::get_property(Variant obj, String property_name) const {
 
 void LuaBridge::set_property(Variant obj, String property_name, Variant value) {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("set_property: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "set_property: Not a Godot object");
 		return;
 	}
 	Object* object = Object::cast_to<Object>(obj.operator Object*());
 	if (!object) {
-		print_to_console("set_property: Invalid object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "set_property: Invalid object");
 		return;
 	}
 	object->set(property_name, value);
@@ -540,18 +957,18 @@ void LuaBridge::set_property(Variant obj, String property_name, Variant value) {
 
 Variant LuaBridge::call_method(Variant obj, String method_name, Array args) {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("call_method: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "call_method: Not a Godot object");
 		return Variant();
 	}
 	
 	Object* object = Object::cast_to<Object>(obj.operator Object*());
 	if (!object) {
-		print_to_console("call_method: Invalid object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "call_method: Invalid object");
 		return Variant();
 	}
 	
 	if (!object->has_method(method_name)) {
-		print_to_console("Method does not exist: " + method_name);
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "Method does not exist: " + method_name);
 		return Variant();
 	}
 	
@@ -561,13 +978,13 @@ Variant LuaBridge::call_method(Variant obj, String method_name, Array args) {
 
 String LuaBridge::get_class(Variant obj) const {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("get_class: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_class: Not a Godot object");
 		return "";
 	}
 	
 	Object* object = Object::cast_to<Object>(obj.operator Object*());
 	if (!object) {
-		print_to_console("get_class: Invalid object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_class: Invalid object");
 		return "";
 	}
 	
@@ -587,19 +1004,19 @@ String LuaBridge::get_class(Variant obj) const {
 
 Variant LuaBridge::get_node(Variant obj, String path) const {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("get_node: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_node: Not a Godot object");
 		return Variant();
 	}
 	
 	Node* node = Object::cast_to<Node>(obj.operator Object*());
 	if (!node) {
-		print_to_console("get_node: Object is not a Node");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_node: Object is not a Node");
 		return Variant();
 	}
 	
 	Node* target_node = node->get_node_or_null(path);
 	if (!target_node) {
-		print_to_console("get_node: Node not found at path: " + path);
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_node: Node not found at path: " + path);
 		return Variant();
 	}
 	
@@ -608,13 +1025,13 @@ Variant LuaBridge::get_node(Variant obj, String path) const {
 
 Array LuaBridge::get_children(Variant obj) const {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("get_children: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_children: Not a Godot object");
 		return Array();
 	}
 	
 	Node* node = Object::cast_to<Node>(obj.operator Object*());
 	if (!node) {
-		print_to_console("get_children: Object is not a Node");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "get_children: Object is not a Node");
 		return Array();
 	}
 	
@@ -631,25 +1048,25 @@ Variant LuaBridge::get_autoload_singleton(String singleton_name) const {
 	MainLoop *main_loop = Engine::get_singleton()->get_main_loop();
 	SceneTree *scene_tree = Object::cast_to<SceneTree>(main_loop);
 	if (!scene_tree) {
-		print_to_console("get_autoload_singleton: SceneTree not available");
+		LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "get_autoload_singleton: SceneTree not available");
 		return Variant();
 	}
 
 	// Get the root window node
 	Window *root = scene_tree->get_root();
 	if (!root) {
-		print_to_console("get_autoload_singleton: No root window node available");
+		LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "get_autoload_singleton: No root window node available");
 		return Variant();
 	}
 
 	// Look for the autoload singleton as a child of the root
 	Node *singleton = root->get_node_or_null(NodePath(singleton_name));
 	if (singleton) {
-		print_to_console("get_autoload_singleton: Found singleton: " + singleton_name);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "get_autoload_singleton: Found singleton: " + singleton_name);
 		return Variant(singleton);
 	}
 
-	print_to_console("get_autoload_singleton: Singleton not found: " + singleton_name);
+	LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "get_autoload_singleton: Singleton not found: " + singleton_name);
 	return Variant();
 }
 
@@ -661,7 +1078,7 @@ Variant LuaBridge::load_resource(String path) const {
 		String mod_path = path.substr(6); // Remove "mod://"
 		int slash_pos = mod_path.find("/");
 		if (slash_pos == -1) {
-			print_to_console("load_resource: Invalid mod path format: " + path);
+			LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "load_resource: Invalid mod path format: " + path);
 			return Variant();
 		}
 		
@@ -671,14 +1088,14 @@ Variant LuaBridge::load_resource(String path) const {
 		// Find the mod directory
 		auto mod_it = loaded_mods.find(mod_name);
 		if (mod_it == loaded_mods.end()) {
-			print_to_console("load_resource: Mod not found: " + mod_name);
+			LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "load_resource: Mod not found: " + mod_name);
 			return Variant();
 		}
 		
 		Dictionary mod_info = mod_it->second;
 		String mod_dir = mod_info.get("mod_dir", "");
 		if (mod_dir.is_empty()) {
-			print_to_console("load_resource: Mod directory not found for: " + mod_name);
+			LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "load_resource: Mod directory not found for: " + mod_name);
 			return Variant();
 		}
 		
@@ -694,32 +1111,32 @@ Variant LuaBridge::load_resource(String path) const {
 		full_path = full_path.simplify_path();
 		
 		// Debug: Print all path components
-		print_to_console("load_resource: mod_name: " + mod_name);
-		print_to_console("load_resource: mod_dir: " + mod_dir);
-		print_to_console("load_resource: asset_path: " + asset_path);
-		print_to_console("load_resource: full_path: " + full_path);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "load_resource: mod_name: " + mod_name);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "load_resource: mod_dir: " + mod_dir);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "load_resource: asset_path: " + asset_path);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "load_resource: full_path: " + full_path);
 		
 		// Check if file exists before attempting to load
 		if (!FileAccess::file_exists(full_path)) {
-			print_to_console("load_resource: File does not exist: " + full_path);
+			LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "load_resource: File does not exist: " + full_path);
 			return Variant();
 		}
 		
 		// Load the resource
 		Ref<Resource> resource = ResourceLoader::get_singleton()->load(full_path);
 		if (!resource.is_valid()) {
-			print_to_console("load_resource: Failed to load mod resource: " + full_path);
+			LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "load_resource: Failed to load mod resource: " + full_path);
 			return Variant();
 		}
 		
-		print_to_console("load_resource: Successfully loaded mod resource: " + full_path);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "load_resource: Successfully loaded mod resource: " + full_path);
 		return resource;
 	}
 	
 	// Handle standard res:// paths for base game assets
 	Ref<Resource> resource = ResourceLoader::get_singleton()->load(path);
 	if (!resource.is_valid()) {
-		print_to_console("load_resource: Failed to load resource: " + path);
+		LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "load_resource: Failed to load resource: " + path);
 		return Variant();
 	}
 	
@@ -729,13 +1146,13 @@ Variant LuaBridge::load_resource(String path) const {
 Variant LuaBridge::instance_scene(String path) const {
 	Ref<PackedScene> scene = ResourceLoader::get_singleton()->load(path);
 	if (!scene.is_valid()) {
-		print_to_console("instance_scene: Failed to load scene: " + path);
+		LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "instance_scene: Failed to load scene: " + path);
 		return Variant();
 	}
 	
 	Node* instance = scene->instantiate();
 	if (!instance) {
-		print_to_console("instance_scene: Failed to instantiate scene: " + path);
+		LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "instance_scene: Failed to instantiate scene: " + path);
 		return Variant();
 	}
 	
@@ -756,19 +1173,26 @@ void LuaBridge::subscribe_event(String name, String func) {
 
 bool LuaBridge::connect_signal(Variant obj, String signal_name, String lua_func_name) {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("connect_signal: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "connect_signal: Not a Godot object");
 		return false;
 	}
 	Object* object = Object::cast_to<Object>(obj.operator Object*());
 	if (!object) {
-		print_to_console("connect_signal: Invalid object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "connect_signal: Invalid object");
 		return false;
 	}
 	
-	Ref<LuaSignalRelay> relay = memnew(LuaSignalRelay);
-	relay->setup(this, lua_func_name);
-	object->connect(signal_name, Callable(relay.ptr(), StringName("_on_signal")));
-	print_to_console("Connected signal '" + signal_name + "' to Lua function '" + lua_func_name + "'");
+	if (!L || is_cleaning_up) {
+		return false;
+	}
+	// Resolve once and connect the function itself; every signal argument is forwarded
+	if (!push_function_by_name(lua_func_name)) {
+		return false;
+	}
+	Callable callable = lua_function_to_callable(L, -1);
+	lua_pop(L, 1);
+	object->connect(signal_name, callable);
+	LUA_LOG_INFO(log_filter, LUA_LOG_BRIDGE, "Connected signal '" + signal_name + "' to Lua function '" + lua_func_name + "'");
 	return true;
 }
 
@@ -841,7 +1265,7 @@ void LuaBridge::setup_game_api() {
 		int nargs = lua_gettop(L);
 		
 		// Debug: Log that the C++ print function was called
-		UtilityFunctions::print("[LuaBridge] C++ print function called with " + String::num_int64(nargs) + " args");
+		LUA_LOG_DEBUG(bridge->log_filter, LUA_LOG_BRIDGE, "C++ print function called with " + String::num_int64(nargs) + " args");
 		
 		for (int i = 1; i <= nargs; ++i) {
 			switch (lua_type(L, i)) {
@@ -860,14 +1284,29 @@ void LuaBridge::setup_game_api() {
 			}
 		}
 
+		// Buffered mode: queue the line and let flush_logs() deliver it between frames
+		if (LuaLog::is_buffered()) {
+			LuaLogRing::Entry entry;
+			entry.level = LUA_LOG_LEVEL_INFO;
+			entry.is_lua_print = true;
+			entry.source_id = bridge->get_instance_id();
+			for (int i = 0; i < args.size(); i++) {
+				entry.message += args[i].operator String();
+				if (i < args.size() - 1)
+					entry.message += " ";
+			}
+			LuaLog::get_ring()->push(std::move(entry));
+			return 0;
+		}
+
 		// Try to call the registered GDScript lua_print function
 		auto it = bridge->registered_functions.find("print");
 		if (it != bridge->registered_functions.end()) {
-			UtilityFunctions::print("[LuaBridge] Found registered print function, calling GDScript...");
+			LUA_LOG_DEBUG(bridge->log_filter, LUA_LOG_BRIDGE, "Found registered print function, calling GDScript...");
 			it->second.callv(args);
 		} else {
 			// fallback: print from C++
-			UtilityFunctions::print("[LuaBridge] No registered print function found, using C++ fallback");
+			LUA_LOG_DEBUG(bridge->log_filter, LUA_LOG_BRIDGE, "No registered print function found, using C++ fallback");
 			String joined;
 			for (int i = 0; i < args.size(); i++) {
 				joined += args[i].operator String();
@@ -881,12 +1320,12 @@ void LuaBridge::setup_game_api() {
 	lua_setglobal(L, "print");
 	
 	// Debug: Confirm print function was installed
-	UtilityFunctions::print("[LuaBridge] print() override installed in setup_game_api()");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "print() override installed in setup_game_api()");
 
 	// Expose Resource-derived classes for direct instantiation
 	expose_classes_to_lua();
 
-	print_to_console("Game API setup complete");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Game API setup complete");
 }
 
 void LuaBridge::setup_safe_libraries() {
@@ -942,7 +1381,7 @@ void LuaBridge::godot_to_lua(lua_State* L, const Variant& value) {
 			lua_pushstring(L, ((String)value).utf8().get_data());
 			break;
 		case Variant::Type::INT:
-			lua_pushinteger(L, (int)value);
+			lua_pushinteger(L, (int64_t)value);
 			break;
 		case Variant::Type::FLOAT:
 			lua_pushnumber(L, (double)value);
@@ -952,43 +1391,83 @@ void LuaBridge::godot_to_lua(lua_State* L, const Variant& value) {
 			break;
 		case Variant::Type::ARRAY:
 			{
+				if (container_proxies_enabled) {
+					push_container_proxy(L, value);
+					break;
+				}
+				// Each nesting level keeps a table (and for Dictionaries a key) on the Lua stack
+				if (!lua_checkstack(L, 3)) {
+					LUA_LOG_ERROR(log_filter, LUA_LOG_CONVERSION, "godot_to_lua: Lua stack exhausted by nested containers");
+					lua_pushnil(L);
+					break;
+				}
 				Array arr = value;
-				lua_newtable(L);
-				for (int i = 0; i < arr.size(); i++) {
-					lua_pushinteger(L, i + 1);
+				int64_t size = arr.size();
+				lua_createtable(L, (int)size, 0);
+				for (int64_t i = 0; i < size; i++) {
 					godot_to_lua(L, arr[i]);
-					lua_settable(L, -3);
+					lua_rawseti(L, -2, i + 1);
 				}
 			}
 			break;
 		case Variant::Type::DICTIONARY:
 			{
+				if (container_proxies_enabled) {
+					push_container_proxy(L, value);
+					break;
+				}
+				if (!lua_checkstack(L, 3)) {
+					LUA_LOG_ERROR(log_filter, LUA_LOG_CONVERSION, "godot_to_lua: Lua stack exhausted by nested containers");
+					lua_pushnil(L);
+					break;
+				}
+				// Walk the Dictionary in place instead of copying keys() and values()
 				Dictionary dict = value;
-				lua_newtable(L);
-				
-				// Get all keys and values
-				Array keys = dict.keys();
-				Array values = dict.values();
-				
-				for (int i = 0; i < keys.size(); i++) {
-					Variant key = keys[i];
-					Variant val = values[i];
-					
-					// Push the key
-					push_variant_to_lua(L, key);
-					
-					// Push the value
-					push_variant_to_lua(L, val);
-					
-					// Set the key-value pair in the table
-					lua_settable(L, -3);
+				lua_createtable(L, 0, (int)dict.size());
+				Variant iter;
+				bool valid = false;
+				bool has_next = value.iter_init(iter, valid) && valid;
+				while (has_next) {
+					Variant key = value.iter_get(iter, valid);
+					if (!valid) {
+						break;
+					}
+					godot_to_lua(L, key);
+					lua_Number numeric_key = lua_tonumber(L, -1);
+					if (lua_isnil(L, -1) || numeric_key != numeric_key) {
+						// nil and NaN cannot be table keys (lua_rawset would raise)
+						lua_pop(L, 1);
+					} else {
+						godot_to_lua(L, dict[key]);
+						lua_rawset(L, -3);
+					}
+					has_next = value.iter_next(iter, valid) && valid;
+				}
+			}
+			break;
+		case Variant::Type::CALLABLE:
+			{
+				// A Lua function that went out as a Callable comes back as the same function
+				const LuaCallable* lua_callable = LuaCallable::from_callable(value);
+				if (lua_callable && lua_callable->get_bridge_id() == ObjectID(get_instance_id())) {
+					lua_rawgeti(L, LUA_REGISTRYINDEX, lua_callable->get_ref());
+				} else if (((Callable)value).is_valid()) {
+					// Any other Callable becomes a Lua function calling it directly
+					Callable callable = value;
+					push_callable_closure(L, String(value), callable, nullptr);
+				} else {
+					lua_pushnil(L);
 				}
 			}
 			break;
 		case Variant::Type::OBJECT:
 			{
 				Object* obj = Object::cast_to<Object>(value.operator Object*());
-				if (obj) {
+				LuaTable* table = Object::cast_to<LuaTable>(obj);
+				if (table && table->get_bridge() == this && table->is_valid()) {
+					// A proxy of one of our own tables goes back as the table itself
+					lua_rawgeti(L, LUA_REGISTRYINDEX, table->get_ref());
+				} else if (obj) {
 					this->push_godot_object_as_userdata(L, obj);
 				} else {
 					lua_pushnil(L);
@@ -996,12 +1475,19 @@ void LuaBridge::godot_to_lua(lua_State* L, const Variant& value) {
 			}
 			break;
 		default:
-			lua_pushnil(L);
+			// Vector2, Color, Transform3D, ... become value type userdata, packed arrays become views
+			if (!lua_push_value_type(L, value) && !lua_push_packed_array(L, value)) {
+				lua_pushnil(L);
+			}
 			break;
 	}
 }
 
 Variant LuaBridge::lua_to_godot(lua_State* L, int index) const {
+	return lua_to_godot(L, index, nullptr);
+}
+
+Variant LuaBridge::lua_to_godot(lua_State* L, int index, LuaConversionContext* context) const {
 	// Convert negative index to absolute index
 	int abs_index = index;
 	if (index < 0) {
@@ -1010,204 +1496,241 @@ Variant LuaBridge::lua_to_godot(lua_State* L, int index) const {
 	
 	// Add safety check for valid absolute index
 	if (abs_index < 1 || abs_index > lua_gettop(L)) {
-		UtilityFunctions::print("[LuaBridge] lua_to_godot: Invalid index " + String::num_int64(index) + " (abs: " + String::num_int64(abs_index) + ")");
+		LUA_LOG_WARN(log_filter, LUA_LOG_CONVERSION, "lua_to_godot: Invalid index " + String::num_int64(index) + " (abs: " + String::num_int64(abs_index) + ")");
 		return Variant();
 	}
 	
-	if (lua_isstring(L, abs_index)) {
-		return String(lua_tostring(L, abs_index));
-	} else if (lua_isnumber(L, abs_index)) {
-		// Check if it's an integer first
-		if (lua_isinteger(L, abs_index)) {
-			return (int64_t)lua_tointeger(L, abs_index);
-		} else {
+	// Dispatch on the actual type: lua_isstring() is also true for numbers
+	switch (lua_type(L, abs_index)) {
+		case LUA_TNIL:
+			return Variant();
+		case LUA_TBOOLEAN:
+			return (bool)lua_toboolean(L, abs_index);
+		case LUA_TNUMBER:
+			if (lua_isinteger(L, abs_index)) {
+				return (int64_t)lua_tointeger(L, abs_index);
+			}
 			return lua_tonumber(L, abs_index);
+		case LUA_TSTRING: {
+			size_t len = 0;
+			const char *str = lua_tolstring(L, abs_index, &len);
+			return String::utf8(str, (int)len);
 		}
-	} else if (lua_isboolean(L, abs_index)) {
-		return (bool)lua_toboolean(L, abs_index);
-	} else if (lua_istable(L, abs_index)) {
-		// Handle Lua tables - convert to either Array or Dictionary
-		Array arr;
-		Dictionary dict;
-		
-		try {
-			// First, try to determine if it's an array by checking sequential numeric keys
-			bool is_array = true;
-			int max_index = 0;
-			
-			// First pass: check if it's a sequential array
-			lua_pushnil(L);
-			while (lua_next(L, abs_index)) {
-				// Check if key is a number
-				if (lua_type(L, -2) == LUA_TNUMBER) {
-					int key = (int)lua_tonumber(L, -2);
-					if (key > 0 && key <= 1000) { // Reasonable array size limit
-						max_index = (key > max_index) ? key : max_index;
-					} else {
-						is_array = false;
-						lua_pop(L, 2); // pop key and value
-						break;
-					}
-				} else {
-					is_array = false;
-					lua_pop(L, 2); // pop key and value
-					break;
-				}
-				lua_pop(L, 1); // pop value, keep key for next iteration
+		case LUA_TTABLE: {
+			if (context) {
+				return lua_table_to_godot(L, abs_index, *context);
 			}
-			
-			// If it's an array, populate it
-			if (is_array && max_index > 0) {
-				for (int i = 1; i <= max_index; i++) {
-					lua_rawgeti(L, abs_index, i);
-					if (lua_isnil(L, -1)) {
-						arr.append(Variant()); // nil becomes null
-					} else {
-						Variant value = lua_to_godot(L, -1);
-						arr.append(value);
-					}
-					lua_pop(L, 1);
-				}
-				return arr;
-			} else {
-				// Convert to dictionary - iterate through all key-value pairs
-				int pair_count = 0;
-				const int MAX_PAIRS = 1000;
-				
-				lua_pushnil(L);
-				while (lua_next(L, abs_index)) {
-					if (pair_count++ > MAX_PAIRS) {
-						UtilityFunctions::print("[LuaBridge] lua_to_godot: Dictionary too large, stopping at " + String::num_int64(MAX_PAIRS) + " pairs");
-						lua_pop(L, 2); // pop key and value
-						break;
-					}
-					
-					// Convert key
-					Variant key;
-					if (lua_type(L, -2) == LUA_TSTRING) {
-						key = String(lua_tostring(L, -2));
-					} else if (lua_type(L, -2) == LUA_TNUMBER) {
-						key = String::num_int64((int)lua_tonumber(L, -2));
-					} else {
-						key = String::num_int64(pair_count); // fallback
-					}
-					
-					// Convert value
-					Variant value;
-					if (lua_isnil(L, -1)) {
-						value = Variant();
-					} else {
-						value = lua_to_godot(L, -1);
-					}
-					
-					dict[key] = value;
-					lua_pop(L, 1); // pop value, keep key for next iteration
-				}
-				return dict;
+			// Top-level table: one context (memo and budgets) for the whole conversion
+			LuaConversionContext root_context;
+			Variant result = lua_table_to_godot(L, abs_index, root_context);
+			if (root_context.failed()) {
+				LUA_LOG_ERROR(log_filter, LUA_LOG_CONVERSION, "lua_to_godot: " + root_context.error);
+				return Variant();
 			}
-		} catch (...) {
-			UtilityFunctions::print("[LuaBridge] lua_to_godot: Exception occurred while converting table, returning empty dictionary");
-			return Dictionary();
-		}
-	} else if (lua_isuserdata(L, abs_index)) {
-		// Handle userdata (wrapped objects)
-		void* userdata_ptr = lua_touserdata(L, abs_index);
-		Variant wrapper_key = Variant((int64_t)userdata_ptr);
-		
-		// Look up the actual object in the wrapper_objects map
-		auto it = this->wrapper_objects.find(wrapper_key);
-		if (it != this->wrapper_objects.end()) {
-			UtilityFunctions::print("[LuaBridge] Found wrapped object for key: " + String::num_int64((int64_t)userdata_ptr));
-			return it->second;
-		} else {
-			UtilityFunctions::print("[LuaBridge] No wrapped object found for key: " + String::num_int64((int64_t)userdata_ptr));
-			return Variant();  // Return nil if not found
+			return result;
 		}
-	} else if (lua_isnil(L, abs_index)) {
-		return Variant();
-	} else {
-		// For unsupported types, return null
-		UtilityFunctions::print("[LuaBridge] lua_to_godot: Unsupported type at index " + String::num_int64(index));
-		return Variant();
+		case LUA_TUSERDATA:
+			return lua_userdata_to_variant(L, abs_index);
+		case LUA_TFUNCTION:
+			return lua_function_to_callable(L, abs_index);
+		default:
+			// For unsupported types, return null
+			LUA_LOG_WARN(log_filter, LUA_LOG_CONVERSION, "lua_to_godot: Unsupported type at index " + String::num_int64(index));
+			return Variant();
 	}
 }
 
-int LuaBridge::lua_call_godot_function(lua_State* L) {
-	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
-	if (!bridge) {
-		lua_pushnil(L);
-		return 1;
-	}
-	
-	const char* func_name = lua_tostring(L, lua_upvalueindex(2));
-	if (!func_name) {
-		lua_pushnil(L);
-		return 1;
+Variant LuaBridge::lua_table_to_godot(lua_State* L, int index, LuaConversionContext& context) const {
+	const void* table_ptr = lua_topointer(L, index);
+	auto converted = context.tables.find(table_ptr);
+	if (converted != context.tables.end()) {
+		if (converted->second.get_type() == Variant::NIL) {
+			context.error = "Table contains a reference cycle";
+			return Variant();
+		}
+		// Shared sub-table: reuse the same Array or Dictionary
+		return converted->second;
 	}
-	
-	String name = String(func_name);
-	
-	// Debug: Log function call and stack state
-	UtilityFunctions::print("[LuaBridge] lua_call_godot_function called for: " + name);
-	UtilityFunctions::print("[LuaBridge] Stack top at function entry: " + String::num_int64(lua_gettop(L)));
-	
-	// Debug: Log when the dictionary function is called
-	if (name == "lua_base_item_factory") {
-		UtilityFunctions::print("[LuaBridge] lua_call_godot_function: Dictionary function called!");
+	if (context.depth >= conversion_max_depth) {
+		context.error = "Table nesting exceeds the maximum depth of " + String::num_int64(conversion_max_depth);
+		return Variant();
 	}
-	
-	auto it = bridge->registered_functions.find(name);
-	if (it == bridge->registered_functions.end()) {
-		lua_pushfstring(L, "[LuaBridge] lua_call_godot_function: Function not found: %s", func_name);
-		lua_error(L);
-		return 0;
+	// Each nesting level keeps a key and a value on the Lua stack
+	if (!lua_checkstack(L, 3)) {
+		context.error = "Lua stack exhausted while converting table";
+		return Variant();
 	}
-	
-	Callable& callable = it->second;
-	
-	// Convert Lua arguments to Godot Array
-	Array args = bridge->lua_to_variant_array(L);
-	
-	UtilityFunctions::print("[LuaBridge] About to call Godot function: " + name);
-	UtilityFunctions::print("[LuaBridge] Arguments array size: " + String::num_int64(args.size()));
-	for (int i = 0; i < args.size(); i++) {
-		UtilityFunctions::print("[LuaBridge] Arg " + String::num_int64(i) + ": " + String(args[i]) + " (type: " + String::num_int64(args[i].get_type()) + ")");
+	context.tables[table_ptr] = Variant();
+	context.depth++;
+
+	// lua_rawlen() returns a border n (t[n] ~= nil, t[n + 1] == nil). A table is
+	// converted to an Array when every key lies in 1..n; holes become null.
+	// The table is walked once: values are converted straight into a pre-sized
+	// Array and only migrated to a Dictionary if a key outside the sequence shows up.
+	lua_Integer length = (lua_Integer)lua_rawlen(L, index);
+	bool is_array = length > 0;
+	Array arr;
+	Dictionary dict;
+	if (is_array) {
+		arr.resize(length);
 	}
-	
-	// Call the Godot function
-	Variant result = callable.callv(args);
-	
-	UtilityFunctions::print("[LuaBridge] Godot function call completed");
-	UtilityFunctions::print("[LuaBridge] Result type: " + String::num_int64(result.get_type()));
 
-	if (result.get_type() == Variant::OBJECT) {
-		Object *obj = result.operator Object *();
-		if (obj) {
-			// Debug the object being returned
-			UtilityFunctions::print("[LuaBridge] get_class(): " + obj->get_class());  // will be "Resource"
+	lua_pushnil(L);
+	while (lua_next(L, index)) {
+		if (conversion_max_elements > 0 && ++context.elements > conversion_max_elements) {
+			context.error = "Table has more than " + String::num_int64(conversion_max_elements) + " entries";
+			lua_pop(L, 2); // pop key and value
+			break;
+		}
+
+		// Key at -2, value at -1. Keys are read without lua_tostring so lua_next stays valid
+		if (is_array && lua_isinteger(L, -2)) {
+			lua_Integer key = lua_tointeger(L, -2);
+			if (key >= 1 && key <= length) {
+				arr[key - 1] = lua_to_godot(L, -1, &context);
+				if (context.failed()) {
+					lua_pop(L, 2); // pop key and value
+					break;
+				}
+				lua_pop(L, 1);
+				continue;
+			}
+		}
 
-			Ref<Script> attached_script = obj->get_script();
-			UtilityFunctions::print("Resource script attached: " + String(!attached_script.is_null() ? "true" : "false"));
+		if (is_array) {
+			// Mixed table: move the sequence entries converted so far into the Dictionary
+			is_array = false;
+			for (lua_Integer i = 1; i <= length; i++) {
+				if (lua_rawgeti(L, index, i) != LUA_TNIL) {
+					dict[(int64_t)i] = arr[i - 1];
+				}
+				lua_pop(L, 1);
+			}
+			arr = Array();
+		}
 
-			if (!attached_script.is_null()) {
-				UtilityFunctions::print("Script class: " + attached_script->get_class());
-				UtilityFunctions::print("Script has methods: " + String::num_int64(attached_script->get_script_method_list().size()));
+		Variant key;
+		switch (lua_type(L, -2)) {
+			case LUA_TNUMBER:
+				key = lua_isinteger(L, -2) ? Variant((int64_t)lua_tointeger(L, -2)) : Variant(lua_tonumber(L, -2));
+				break;
+			case LUA_TSTRING: {
+				size_t len = 0;
+				const char *str = lua_tolstring(L, -2, &len);
+				key = String::utf8(str, (int)len);
+				break;
 			}
-			
-			bridge->push_godot_object_as_userdata(L, obj);
-			return 1;
+			default:
+				key = lua_to_godot(L, -2, &context);
+				break;
+		}
+		Variant value = context.failed() ? Variant() : lua_to_godot(L, -1, &context);
+		if (context.failed()) {
+			lua_pop(L, 2); // pop key and value
+			break;
 		}
+		dict[key] = value;
+		lua_pop(L, 1); // pop value, keep key for next iteration
+	}
+
+	context.depth--;
+	if (context.failed()) {
+		return Variant();
+	}
+	Variant result = is_array ? Variant(arr) : Variant(dict);
+	context.tables[table_ptr] = result;
+	return result;
+}
+
+Callable LuaBridge::lua_function_to_callable(lua_State* L, int index) const {
+	index = lua_absindex(L, index);
+	const void* function_ptr = lua_topointer(L, index);
+
+	lua_Debug ar;
+	lua_pushvalue(L, index);
+	lua_getinfo(L, ">S", &ar); // pops the function
+	String text = "LuaFunction(" + String::utf8(ar.short_src) + ":" + String::num_int64(ar.linedefined) + ")";
+
+	lua_pushvalue(L, index);
+	int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	return Callable(memnew(LuaCallable(ObjectID(get_instance_id()), ref, function_ptr, text)));
+}
+
+Variant LuaBridge::lua_to_godot_lazy(lua_State* L, int index) const {
+	if (lua_type(L, index) != LUA_TTABLE) {
+		return lua_to_godot(L, index);
+	}
+	// Pin the table and hand out a proxy; nothing is converted until it is read
+	lua_pushvalue(L, index);
+	int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	Ref<LuaTable> table;
+	table.instantiate();
+	table->setup(Ref<LuaBridge>(const_cast<LuaBridge*>(this)), ref);
+	return table;
+}
+
+int LuaBridge::lua_call_godot_function(lua_State* L) {
+	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
+	RegisteredFunction* fn = static_cast<RegisteredFunction*>(lua_touserdata(L, lua_upvalueindex(2)));
+	if (!bridge || !fn) {
 		lua_pushnil(L);
 		return 1;
 	}
-	bridge->push_variant_to_lua(L, result);
-	return 1;
+	
+	int top = lua_gettop(L);
+	int argc = fn->has_signature ? (int)fn->arg_types.size() : top;
+	
+	// Errors are raised after the Variants below go out of scope, since lua_error longjmps
+	char error_buf[256];
+	error_buf[0] = '\0';
+	{
+		CallArguments args(argc);
+		for (int i = 0; i < argc; i++) {
+			if (i >= top) {
+				// Declared but not passed: leave as null
+			} else if (fn->has_signature) {
+				bridge->lua_to_typed_variant(L, i + 1, fn->arg_types[i], args.argv[i]);
+			} else {
+				args.argv[i] = bridge->lua_to_godot(L, i + 1);
+			}
+			args.argp[i] = &args.argv[i];
+		}
+		
+		Variant result;
+		GDExtensionCallError call_error;
+		fn->callable.callp(fn->call_method, args.argp, argc, result, call_error);
+		
+		if (call_error.error == GDEXTENSION_CALL_OK) {
+			lua_settop(L, 0);
+			bridge->godot_to_lua(L, result);
+			return 1;
+		}
+		
+		CharString name = fn->name.utf8();
+		switch (call_error.error) {
+			case GDEXTENSION_CALL_ERROR_INVALID_ARGUMENT:
+				snprintf(error_buf, sizeof(error_buf), "[LuaBridge] %s: invalid argument #%d, expected %s",
+						name.get_data(), call_error.argument + 1,
+						Variant::get_type_name((Variant::Type)call_error.expected).utf8().get_data());
+				break;
+			case GDEXTENSION_CALL_ERROR_TOO_MANY_ARGUMENTS:
+			case GDEXTENSION_CALL_ERROR_TOO_FEW_ARGUMENTS:
+				snprintf(error_buf, sizeof(error_buf), "[LuaBridge] %s: expected %d arguments, got %d",
+						name.get_data(), call_error.expected, argc);
+				break;
+			default:
+				snprintf(error_buf, sizeof(error_buf), "[LuaBridge] %s: call failed (error %d)",
+						name.get_data(), (int)call_error.error);
+				break;
+		}
+	}
+	return luaL_error(L, "%s", error_buf);
 }
 
 bool LuaBridge::load_mods_from_directory(String mods_dir) {
 	if (!L) return false;
 	
-	print_to_console("Loading mods from directory: " + mods_dir);
+	LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Loading mods from directory: " + mods_dir);
 	
 	// Get the directory access
 	Ref<DirAccess> dir = DirAccess::open(mods_dir);
@@ -1226,20 +1749,20 @@ bool LuaBridge::load_mods_from_directory(String mods_dir) {
 			String mod_path = mods_dir.path_join(filename);
 			String mod_json_path = mod_path.path_join("mod.json");
 			
-			print_to_console("Checking for mod.json in: " + mod_json_path);
+			LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Checking for mod.json in: " + mod_json_path);
 			
 			// Check if mod.json exists
 			if (FileAccess::file_exists(mod_json_path)) {
-				print_to_console("Found mod.json: " + mod_json_path);
+				LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Found mod.json: " + mod_json_path);
 				
 				// Load the mod
 				if (load_mod_from_json(mod_json_path)) {
-					print_to_console("Successfully loaded mod from: " + mod_json_path);
+					LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Successfully loaded mod from: " + mod_json_path);
 				} else {
-					print_to_console("Failed to load mod from: " + mod_json_path);
+					LUA_LOG_WARN(log_filter, LUA_LOG_MODS, "Failed to load mod from: " + mod_json_path);
 				}
 			} else {
-				print_to_console("No mod.json found in: " + mod_path);
+				LUA_LOG_WARN(log_filter, LUA_LOG_MODS, "No mod.json found in: " + mod_path);
 			}
 		}
 		
@@ -1248,14 +1771,14 @@ bool LuaBridge::load_mods_from_directory(String mods_dir) {
 	
 	dir->list_dir_end();
 	
-	print_to_console("Mod loading completed. Loaded " + String::num_int64(loaded_mods.size()) + " mods");
+	LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Mod loading completed. Loaded " + String::num_int64(loaded_mods.size()) + " mods");
 	return true;
 }
 
 bool LuaBridge::load_mod_from_json(String mod_json_path) {
 	if (!L) return false;
 	
-	print_to_console("Loading mod from JSON: " + mod_json_path);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Loading mod from JSON: " + mod_json_path);
 	
 	// Read the JSON file
 	Ref<FileAccess> file = FileAccess::open(mod_json_path, FileAccess::READ);
@@ -1316,7 +1839,7 @@ bool LuaBridge::load_mod_from_json(String mod_json_path) {
 		return false;
 	}
 	
-	print_to_console("Mod info - Name: " + mod_name + ", Version: " + version + ", Enabled: " + (enabled ? "true" : "false"));
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Mod info - Name: " + mod_name + ", Version: " + version + ", Enabled: " + (enabled ? "true" : "false"));
 	
 	// Store mod information
 	Dictionary mod_info;
@@ -1331,16 +1854,24 @@ bool LuaBridge::load_mod_from_json(String mod_json_path) {
 	
 	// Get the mod directory path
 	String mod_dir = mod_json_path.get_base_dir();
-	print_to_console("load_mod_from_json: Raw mod_dir from get_base_dir(): " + mod_dir);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "load_mod_from_json: Raw mod_dir from get_base_dir(): " + mod_dir);
 	
 	// Ensure mod_dir is a resource path
 	if (!mod_dir.begins_with("res://") && !mod_dir.begins_with("user://")) {
 		mod_dir = "res://" + mod_dir.trim_prefix("./").trim_prefix("/");
-		print_to_console("load_mod_from_json: Normalized mod_dir to: " + mod_dir);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "load_mod_from_json: Normalized mod_dir to: " + mod_dir);
 	}
 	
 	mod_info["mod_dir"] = mod_dir;
-	print_to_console("load_mod_from_json: Stored mod_dir for " + mod_name + ": " + mod_dir);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "load_mod_from_json: Stored mod_dir for " + mod_name + ": " + mod_dir);
+	
+	// Optional memory budget in bytes, 0 for no limit. Reloading keeps the mod's accounting.
+	int64_t memory_limit = mod_dict.get("memory_limit", 0);
+	if (memory_limit < 0) {
+		memory_limit = 0;
+	}
+	mod_info["memory_limit"] = memory_limit;
+	uint32_t memory_owner = get_mod_memory_owner(mod_name, mod_dir, memory_limit);
 	
 	loaded_mods[mod_name] = mod_info;
 	mod_enabled_status[mod_name] = enabled;
@@ -1348,11 +1879,18 @@ bool LuaBridge::load_mod_from_json(String mod_json_path) {
 	// Load the entry script if it exists and mod is enabled
 	if (enabled && !entry_script.is_empty()) {
 		String script_path = mod_dir.path_join(entry_script);
-		print_to_console("Loading entry script: " + script_path);
+		LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Loading entry script: " + script_path);
 		
 		if (FileAccess::file_exists(script_path)) {
-			if (load_file(script_path)) {
-				print_to_console("Successfully loaded entry script: " + script_path);
+			// Everything the entry script allocates at load time belongs to the mod
+			uint32_t previous_owner = allocator->get_current_owner();
+			allocator->set_current_owner(memory_owner);
+			bool loaded = load_file(script_path);
+			allocator->set_current_owner(previous_owner);
+			emit_memory_budget_events();
+			
+			if (loaded) {
+				LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Successfully loaded entry script: " + script_path);
 			} else {
 				String error_msg = "Failed to load entry script: " + script_path;
 				log_error(error_msg);
@@ -1365,22 +1903,22 @@ bool LuaBridge::load_mod_from_json(String mod_json_path) {
 		}
 	}
 	
-	print_to_console("Successfully loaded mod: " + mod_name);
+	LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Successfully loaded mod: " + mod_name);
 	return true;
 }
 
 void LuaBridge::enable_mod(String mod_name) {
-	print_to_console("Enabling mod: " + mod_name);
+	LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Enabling mod: " + mod_name);
 	mod_enabled_status[mod_name] = true;
 }
 
 void LuaBridge::disable_mod(String mod_name) {
-	print_to_console("Disabling mod: " + mod_name);
+	LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Disabling mod: " + mod_name);
 	mod_enabled_status[mod_name] = false;
 }
 
 bool LuaBridge::reload_mod(String mod_name) {
-	print_to_console("Reloading mod: " + mod_name);
+	LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Reloading mod: " + mod_name);
 	
 	auto it = loaded_mods.find(mod_name);
 	if (it == loaded_mods.end()) {
@@ -1402,13 +1940,19 @@ bool LuaBridge::reload_mod(String mod_name) {
 	loaded_mods.erase(mod_name);
 	mod_enabled_status.erase(mod_name);
 	
+	// Reloading replaces the mod's functions, so handles pinned to them are stale
+	invalidate_function_handles(mod_info.get("mod_dir", ""));
+	
+	// Modules the mod required are loaded again from the new code
+	invalidate_module_cache(mod_name, mod_info.get("mod_dir", ""));
+	
 	// Reload the mod
 	bool success = load_mod_from_json(json_path);
 	
 	if (success) {
-		print_to_console("Successfully reloaded mod: " + mod_name);
+		LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Successfully reloaded mod: " + mod_name);
 	} else {
-		print_to_console("Failed to reload mod: " + mod_name);
+		LUA_LOG_WARN(log_filter, LUA_LOG_MODS, "Failed to reload mod: " + mod_name);
 	}
 	
 	return success;
@@ -1424,26 +1968,28 @@ Array LuaBridge::get_all_mod_info() const {
 		// Create a copy of the mod info and add the enabled status
 		Dictionary info_copy = mod_info;
 		info_copy["enabled"] = is_mod_enabled(mod_name);
+		info_copy["memory_in_use"] = get_mod_memory_usage(mod_name);
 		
 		mod_info_array.append(info_copy);
 	}
 	
-	print_to_console("Returning info for " + String::num_int64(mod_info_array.size()) + " mods");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Returning info for " + String::num_int64(mod_info_array.size()) + " mods");
 	return mod_info_array;
 }
 
 Dictionary LuaBridge::get_mod_info(String mod_name) const {
 	auto it = loaded_mods.find(mod_name);
 	if (it == loaded_mods.end()) {
-		print_to_console("Mod not found: " + mod_name);
+		LUA_LOG_WARN(log_filter, LUA_LOG_MODS, "Mod not found: " + mod_name);
 		return Dictionary();
 	}
 	
 	// Create a copy of the mod info and add the enabled status
 	Dictionary info_copy = it->second;
 	info_copy["enabled"] = is_mod_enabled(mod_name);
+	info_copy["memory_in_use"] = get_mod_memory_usage(mod_name);
 	
-	print_to_console("Returning info for mod: " + mod_name);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Returning info for mod: " + mod_name);
 	return info_copy;
 }
 
@@ -1455,7 +2001,7 @@ bool LuaBridge::is_mod_enabled(String mod_name) const {
 void LuaBridge::call_on_init() {
 	if (!L) return;
 	
-	print_to_console("Calling on_init lifecycle hook");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Calling on_init lifecycle hook");
 	lifecycle_initialized = true;
 	
 	// Call the on_init function if it exists
@@ -1465,7 +2011,7 @@ void LuaBridge::call_on_init() {
 void LuaBridge::call_on_ready() {
 	if (!L) return;
 	
-	print_to_console("Calling on_ready lifecycle hook");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Calling on_ready lifecycle hook");
 	lifecycle_ready = true;
 	
 	// Call the on_ready function if it exists
@@ -1479,12 +2025,22 @@ void LuaBridge::call_on_update(float delta) {
 	
 	// Call the on_update function if it exists
 	call_function("on_update", Array::make(delta));
+	
+	// Collect at a known point of the frame instead of wherever Lua happens to allocate
+	if (is_gc_frame_driven()) {
+		run_frame_gc(delta);
+	}
+	
+	// Deliver buffered Lua prints and diagnostics once per frame
+	if (LuaLog::is_buffered()) {
+		flush_logs();
+	}
 }
 
 void LuaBridge::call_on_exit() {
 	if (!L) return;
 	
-	print_to_console("Calling on_exit lifecycle hook");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Calling on_exit lifecycle hook");
 	lifecycle_initialized = false;
 	lifecycle_ready = false;
 	
@@ -1492,14 +2048,14 @@ void LuaBridge::call_on_exit() {
 	try {
 		call_function("on_exit", Array());
 	} catch (...) {
-		print_to_console("Exception during on_exit call, continuing cleanup...");
+		LUA_LOG_WARN(log_filter, LUA_LOG_MODS, "Exception during on_exit call, continuing cleanup...");
 	}
 }
 
 bool LuaBridge::create_coroutine(String name, String func_name, Array args) {
 	if (!L) return false;
 	
-	print_to_console("Creating coroutine: " + name + " with function: " + func_name);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Creating coroutine: " + name + " with function: " + func_name);
 	
 	// For now, just mark as active
 	coroutine_active[name] = true;
@@ -1509,7 +2065,7 @@ bool LuaBridge::create_coroutine(String name, String func_name, Array args) {
 bool LuaBridge::resume_coroutine(String name, Variant data) {
 	if (!L) return false;
 	
-	print_to_console("Resuming coroutine: " + name);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Resuming coroutine: " + name);
 	
 	// For now, just return true
 	return true;
@@ -1521,17 +2077,17 @@ bool LuaBridge::is_coroutine_active(String name) const {
 }
 
 void LuaBridge::cleanup_coroutines() {
-	print_to_console("Cleaning up coroutines");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_MODS, "Cleaning up coroutines");
 	coroutine_active.clear();
 }
 
 Variant LuaBridge::create_wrapper(Variant obj, String class_name) {
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("create_wrapper: Not a Godot object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "create_wrapper: Not a Godot object");
 		return Variant();
 	}
 	
-	print_to_console("Creating wrapper for: " + class_name);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Creating wrapper for: " + class_name);
 	
 	// Store the wrapper mapping
 	object_wrappers[obj] = class_name;
@@ -1546,7 +2102,7 @@ bool LuaBridge::is_wrapper(Variant obj) const {
 
 Variant LuaBridge::unwrap_object(Variant wrapper) const {
 	if (!is_wrapper(wrapper)) {
-		print_to_console("unwrap_object: Not a wrapper");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "unwrap_object: Not a wrapper");
 		return Variant();
 	}
 	
@@ -1577,13 +2133,13 @@ bool LuaBridge::is_wrapper_valid(Variant wrapper) const {
 
 Variant LuaBridge::safe_call_method(Variant wrapper, String method_name, Array args) {
 	if (!is_wrapper_valid(wrapper)) {
-		print_to_console("safe_call_method: Invalid wrapper");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "safe_call_method: Invalid wrapper");
 		return Variant();
 	}
 	
 	Variant obj = unwrap_object(wrapper);
 	if (obj.get_type() != Variant::Type::OBJECT) {
-		print_to_console("safe_call_method: Cannot unwrap object");
+		LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "safe_call_method: Cannot unwrap object");
 		return Variant();
 	}
 	
@@ -1608,22 +2164,22 @@ bool LuaBridge::is_instance(Variant obj, String class_name) const {
 Variant LuaBridge::create_instance(String class_name, Array args) {
 	if (!L) return Variant();
 	
-	print_to_console("Creating instance of class: " + class_name);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "Creating instance of class: " + class_name);
 	
 	// Check if the class can be instantiated
 	if (!ClassDB::can_instantiate(class_name)) {
-		print_to_console("Cannot instantiate class: " + class_name);
+		LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "Cannot instantiate class: " + class_name);
 		return Variant();
 	}
 	
 	// Create the instance
 	Object* instance = ClassDB::instantiate(class_name);
 	if (!instance) {
-		print_to_console("Failed to create instance of class: " + class_name);
+		LUA_LOG_WARN(log_filter, LUA_LOG_RESOURCES, "Failed to create instance of class: " + class_name);
 		return Variant();
 	}
 	
-	print_to_console("Successfully created instance of class: " + class_name);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_RESOURCES, "Successfully created instance of class: " + class_name);
 	return Variant(instance);
 }
 
@@ -1648,7 +2204,7 @@ Array LuaBridge::get_instantiable_classes() const {
 void LuaBridge::expose_classes_to_lua() {
 	if (!L) return;
 	
-	print_to_console("Exposing classes to Lua...");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Exposing classes to Lua...");
 	
 	// Create a global table for classes
 	lua_newtable(L);
@@ -1663,7 +2219,7 @@ void LuaBridge::expose_classes_to_lua() {
 	// Set the classes table as a global
 	lua_setglobal(L, "Classes");
 	
-	print_to_console("Classes exposed to Lua");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Classes exposed to Lua");
 }
 
 void LuaBridge::expose_class_to_lua(String class_name) {
@@ -1674,7 +2230,7 @@ void LuaBridge::expose_class_to_lua(String class_name) {
 	if (!lua_istable(L, -1)) {
 		lua_getglobal(L, "Classes");
 		if (!lua_istable(L, -1)) {
-			print_to_console("Classes table not found, creating it...");
+			LUA_LOG_WARN(log_filter, LUA_LOG_BRIDGE, "Classes table not found, creating it...");
 			lua_pop(L, 1); // Pop the nil value
 			lua_newtable(L); // Create a new table
 		}
@@ -1691,15 +2247,13 @@ void LuaBridge::expose_class_to_lua(String class_name) {
 	// Don't pop the table - keep it on stack for next class
 	// The table will be popped when we set it as global in expose_classes_to_lua
 	
-	print_to_console("Exposed class: " + class_name);
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Exposed class: " + class_name);
 }
 
 // Definitions for static helper functions
 int LuaBridge::lua_godot_object_newindex(lua_State *L) {
-	Object **ud = static_cast<Object **>(luaL_checkudata(L, 1, "GodotObject"));
-	if (!ud || !*ud) return 0;
+	Object *obj = check_wrapped_object(L, 1);
 	
-	Object *obj = *ud;
 	const char *key = lua_tostring(L, 2);
 	if (!key) return 0;
 	
@@ -1708,11 +2262,7 @@ int LuaBridge::lua_godot_object_newindex(lua_State *L) {
 		case LUA_TSTRING: value = String(lua_tostring(L, 3)); break;
 		case LUA_TNUMBER: value = lua_tonumber(L, 3); break;
 		case LUA_TBOOLEAN: value = lua_toboolean(L, 3); break;
-		case LUA_TUSERDATA: {
-			void* userdata_ptr = lua_touserdata(L, 3);
-			Variant wrapper_key = Variant((int64_t)userdata_ptr);
-			return wrapper_key;
-		}
+		case LUA_TUSERDATA: value = lua_userdata_to_variant(L, 3); break;
 		default: value = Variant(); break;
 	}
 	
@@ -1721,505 +2271,617 @@ int LuaBridge::lua_godot_object_newindex(lua_State *L) {
 }
 
 int LuaBridge::lua_godot_object_tostring(lua_State *L) {
-	UtilityFunctions::print("[LuaBridge] __tostring called");
-	
-	// Safety check: ensure we have userdata
-	if (!lua_isuserdata(L, 1)) {
-		UtilityFunctions::print("[LuaBridge] __tostring: argument is not userdata");
-		lua_pushstring(L, "GodotObject: <invalid - not userdata>");
+	GodotObjectUserData *ud = static_cast<GodotObjectUserData *>(luaL_testudata(L, 1, "GodotObject"));
+	if (!ud) {
+		lua_pushstring(L, "GodotObject: <invalid>");
+		return 1;
+	}
+	if (!get_wrapped_object(L, 1)) {
+		lua_pushfstring(L, "GodotObject:%I <freed>", (lua_Integer)ud->instance_id);
 		return 1;
 	}
 	
-	// Get the userdata
-	Object **ud = static_cast<Object **>(luaL_checkudata(L, 1, "GodotObject"));
+	// Create a safe string representation without calling object methods
+	lua_pushfstring(L, "GodotObject:%I", (lua_Integer)ud->instance_id);
+	return 1;
+}
+
+int LuaBridge::lua_godot_object_gc(lua_State *L) {
+	// Nothing to unregister: the userdata owns everything it references
+	GodotObjectUserData *ud = static_cast<GodotObjectUserData *>(luaL_testudata(L, 1, "GodotObject"));
+	if (ud) {
+		ud->~GodotObjectUserData();
+	}
+	return 0;
+}
+
+Object* LuaBridge::get_wrapped_object(lua_State* L, int index) {
+	GodotObjectUserData* ud = static_cast<GodotObjectUserData*>(luaL_testudata(L, index, "GodotObject"));
 	if (!ud) {
-		UtilityFunctions::print("[LuaBridge] __tostring: failed to get userdata");
-		lua_pushstring(L, "GodotObject: <invalid - no userdata>");
+		return nullptr;
+	}
+	if (ud->resource_ref.is_valid()) {
+		return ud->resource_ref.ptr();
+	}
+	// Returns null once the object has been freed
+	return ObjectDB::get_instance(ud->instance_id);
+}
+
+Object* LuaBridge::check_wrapped_object(lua_State* L, int index) {
+	GodotObjectUserData* ud = static_cast<GodotObjectUserData*>(luaL_checkudata(L, index, "GodotObject"));
+	Object* obj = ud->resource_ref.is_valid() ? ud->resource_ref.ptr() : ObjectDB::get_instance(ud->instance_id);
+	if (!obj) {
+		luaL_error(L, "[LuaBridge] attempt to use a freed Godot object (id %I)", (lua_Integer)ud->instance_id);
+	}
+	return obj;
+}
+
+int LuaBridge::lua_is_instance_valid(lua_State* L) {
+	lua_pushboolean(L, get_wrapped_object(L, 1) != nullptr);
+	return 1;
+}
+
+// Stable key for a wrapped object, e.g. to index Lua tables by object; nil gives 0
+static int64_t native_get_instance_id(Object* obj) {
+	return obj ? (int64_t)obj->get_instance_id() : 0;
+}
+
+static uint64_t get_script_id(Object* obj) {
+	Ref<Script> script = obj->get_script();
+	return script.is_valid() ? (uint64_t)script->get_instance_id() : 0;
+}
+
+String LuaBridge::get_method_cache_key(Object* obj) {
+	// Script-attached objects share a native class but not a method set, so the script is part of the key
+	String class_key = obj->get_class();
+	uint64_t script_id = get_script_id(obj);
+	if (script_id != 0) {
+		class_key += "#" + String::num_uint64(script_id);
+	}
+	return class_key;
+}
+
+void LuaBridge::push_method_table(lua_State* L, Object* obj) {
+	lua_getfield(L, LUA_REGISTRYINDEX, "godot_method_cache");
+	CharString class_key = get_method_cache_key(obj).utf8();
+	if (lua_getfield(L, -1, class_key.get_data()) != LUA_TTABLE) {
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, -3, class_key.get_data());
+	}
+	lua_remove(L, -2); // Remove the cache table
+}
+
+int LuaBridge::godot_object_index(lua_State* L) {
+	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
+	
+	// The wrapper outlives script changes on its object: attaching or swapping a script
+	// switches to that script's method table, so neither cached closures nor cached misses go stale
+	if (Object* obj = get_wrapped_object(L, 1)) {
+		GodotObjectUserData* ud = static_cast<GodotObjectUserData*>(lua_touserdata(L, 1));
+		uint64_t script_id = get_script_id(obj);
+		if (script_id != ud->script_id && bridge) {
+			bridge->push_method_table(L, obj);
+			lua_setiuservalue(L, 1, 1);
+			ud->script_id = script_id;
+		}
+	}
+	
+	// Fast path: the userdata carries its class method table as user value 1
+	if (lua_getiuservalue(L, 1, 1) == LUA_TTABLE) {
+		lua_pushvalue(L, 2);
+		int cached_type = lua_rawget(L, -2);
+		if (cached_type == LUA_TFUNCTION) {
+			return 1;
+		}
+		if (cached_type == LUA_TBOOLEAN) {
+			// Cached miss: the class has no such method
+			lua_pushnil(L);
+			return 1;
+		}
+		lua_pop(L, 1);
+	}
+	int method_table = lua_gettop(L);
+	
+	if (!bridge) {
+		lua_pushnil(L);
 		return 1;
 	}
 	
-	if (!*ud) {
-		UtilityFunctions::print("[LuaBridge] __tostring: object pointer is null");
-		lua_pushstring(L, "GodotObject: <null>");
+	Object* obj = check_wrapped_object(L, 1);
+	if (lua_type(L, 2) != LUA_TSTRING) {
+		lua_pushnil(L);
 		return 1;
 	}
 	
-	Object *obj = *ud;
-	UtilityFunctions::print("[LuaBridge] __tostring: object pointer valid: " + String::num_int64((int64_t)obj));
+	const char* key = lua_tostring(L, 2);
+	if (!obj->has_method(key)) {
+		if (lua_istable(L, method_table)) {
+			lua_pushvalue(L, 2);
+			lua_pushboolean(L, 0);
+			lua_rawset(L, method_table);
+		}
+		lua_pushnil(L);
+		return 1;
+	}
 	
-	// Create a safe string representation without calling object methods
-	String obj_id = String::num_int64((int64_t)obj);
-	String result = "GodotObject:" + obj_id;
+	LUA_LOG_DEBUG(bridge->log_filter, LUA_LOG_BRIDGE, "Caching method closure: " + obj->get_class() + "." + String(key));
 	
-	UtilityFunctions::print("[LuaBridge] __tostring: returning: " + result);
+	// Closure: upvalue 1 = bridge, upvalue 2 = resolved call signature; the object arrives as self
+	lua_pushlightuserdata(L, bridge);
+	BoundMethodInfo* info = static_cast<BoundMethodInfo*>(lua_newuserdatauv(L, sizeof(BoundMethodInfo), 0));
+	new (info) BoundMethodInfo();
+	luaL_setmetatable(L, "GodotMethodInfo");
+	resolve_method_info(obj, key, info);
+	lua_pushcclosure(L, lua_godot_method_call, 2);
 	
-	lua_pushstring(L, result.utf8().get_data());
+	if (lua_istable(L, method_table)) {
+		lua_pushvalue(L, 2);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, method_table);
+	}
 	return 1;
 }
 
-int LuaBridge::lua_godot_object_gc(lua_State *L) {
-	UtilityFunctions::print("[LuaBridge] __gc called");
-	
-	// Check if Lua state is still valid
-	if (!L) {
-		UtilityFunctions::print("[LuaBridge] __gc: Lua state is null, skipping...");
-		return 0;
-	}
-	
-	// Retrieve LuaBridge pointer from Lua registry
-	lua_getfield(L, LUA_REGISTRYINDEX, "godot_lua_bridge_ptr");
-	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, -1));
-	lua_pop(L, 1);
+void LuaBridge::resolve_method_info(Object* obj, const char* method_name, BoundMethodInfo* info) {
+	info->name = StringName(method_name);
 	
-	// If bridge pointer is not found, we're in cleanup mode - just clean up the userdata directly
-	if (!bridge) {
-		UtilityFunctions::print("[LuaBridge] __gc: bridge pointer not found - cleaning up userdata directly");
+	// The method list includes script methods, which ClassDB does not know about
+	TypedArray<Dictionary> methods = obj->get_method_list();
+	for (int i = 0; i < methods.size(); i++) {
+		Dictionary method = methods[i];
+		if (StringName(method.get("name", "")) != info->name) {
+			continue;
+		}
 		
-		// Get the userdata size to determine the type
-		size_t userdata_size = lua_rawlen(L, 1);
-		UtilityFunctions::print("[LuaBridge] __gc: userdata size: " + String::num_int64(userdata_size));
+		Array method_args = method.get("args", Array());
+		info->arg_types.reserve(method_args.size());
+		for (int j = 0; j < method_args.size(); j++) {
+			Dictionary arg = method_args[j];
+			info->arg_types.push_back((Variant::Type)(int)arg.get("type", (int)Variant::NIL));
+		}
 		
-		// Check if this is ResourceUserData (should be sizeof(ResourceUserData))
-		if (userdata_size == sizeof(ResourceUserData)) {
-			ResourceUserData* resource_ud = static_cast<ResourceUserData*>(lua_touserdata(L, 1));
-			if (resource_ud) {
-				UtilityFunctions::print("[LuaBridge] __gc: cleaning up ResourceUserData directly");
-				
-				// Clean up the resource reference
-				if (resource_ud->resource_ref.is_valid()) {
-					UtilityFunctions::print("[LuaBridge] __gc: resource_ref is valid, cleaning up");
-					resource_ud->resource_ref.~Ref<Resource>(); // Explicitly call destructor
+		Dictionary return_info = method.get("return", Dictionary());
+		info->return_type = (Variant::Type)(int)return_info.get("type", (int)Variant::NIL);
+		info->is_vararg = ((int)method.get("flags", 0) & METHOD_FLAG_VARARG) != 0;
+		return;
+	}
+}
+
+void LuaBridge::lua_to_typed_variant(lua_State* L, int index, Variant::Type type, Variant& r_value) const {
+	int lua_value_type = lua_type(L, index);
+	switch (type) {
+		case Variant::INT:
+			if (lua_value_type == LUA_TNUMBER) {
+				r_value = lua_isinteger(L, index) ? (int64_t)lua_tointeger(L, index) : (int64_t)lua_tonumber(L, index);
+				return;
+			}
+			break;
+		case Variant::FLOAT:
+			if (lua_value_type == LUA_TNUMBER) {
+				r_value = (double)lua_tonumber(L, index);
+				return;
+			}
+			break;
+		case Variant::BOOL:
+			if (lua_value_type == LUA_TBOOLEAN) {
+				r_value = (bool)lua_toboolean(L, index);
+				return;
+			}
+			break;
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH:
+			if (lua_value_type == LUA_TSTRING) {
+				size_t len = 0;
+				const char* str = lua_tolstring(L, index, &len);
+				String value = String::utf8(str, (int)len);
+				if (type == Variant::STRING_NAME) {
+					r_value = StringName(value);
+				} else if (type == Variant::NODE_PATH) {
+					r_value = NodePath(value);
 				} else {
-					UtilityFunctions::print("[LuaBridge] __gc: resource_ref is not valid, cleaning up anyway");
-					resource_ud->resource_ref.~Ref<Resource>(); // Explicitly call destructor
+					r_value = value;
 				}
-				
-				resource_ud->obj_ptr = nullptr;
-				UtilityFunctions::print("[LuaBridge] __gc: ResourceUserData cleaned up directly");
+				return;
+			}
+			break;
+		case Variant::OBJECT:
+			if (lua_value_type == LUA_TNIL) {
+				r_value = Variant();
+				return;
 			}
-		} else if (userdata_size == sizeof(Object*)) {
-			// This is a regular Object** userdata
-			Object **ud = static_cast<Object **>(lua_touserdata(L, 1));
-			if (ud && *ud) {
-				UtilityFunctions::print("[LuaBridge] __gc: cleaning up Object** structure directly, obj ptr: " + String::num_int64((int64_t)*ud));
-				*ud = nullptr;
-				UtilityFunctions::print("[LuaBridge] __gc: Object** cleaned up directly");
+			if (Object* obj = get_wrapped_object(L, index)) {
+				r_value = obj;
+				return;
 			}
-		} else {
-			UtilityFunctions::print("[LuaBridge] __gc: unknown userdata size: " + String::num_int64(userdata_size));
-		}
-		return 0;
+			break;
+		default:
+			break;
 	}
 	
-	// Check if bridge is being cleaned up
-	if (bridge->is_cleaning_up) {
-		UtilityFunctions::print("[LuaBridge] __gc: bridge is being cleaned up, skipping...");
-		return 0;
+	// Untyped (Variant) parameter or a value Godot has to convert itself
+	r_value = lua_to_godot(L, index);
+}
+
+void LuaBridge::push_typed_return(lua_State* L, Variant::Type type, const Variant& value) {
+	switch (type) {
+		case Variant::BOOL:
+			lua_pushboolean(L, (bool)value);
+			break;
+		case Variant::INT:
+			lua_pushinteger(L, (int64_t)value);
+			break;
+		case Variant::FLOAT:
+			lua_pushnumber(L, (double)value);
+			break;
+		case Variant::STRING: {
+			CharString utf8 = ((String)value).utf8();
+			lua_pushlstring(L, utf8.get_data(), utf8.length());
+			break;
+		}
+		default:
+			godot_to_lua(L, value);
+			break;
+	}
+}
+
+int LuaBridge::lua_godot_method_call(lua_State* L) {
+	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
+	const BoundMethodInfo* info = static_cast<const BoundMethodInfo*>(lua_touserdata(L, lua_upvalueindex(2)));
+	if (!bridge || !info) {
+		lua_pushnil(L);
+		return 1;
 	}
 	
-	// Check if bridge's Lua state is still valid
-	if (!bridge->L) {
-		UtilityFunctions::print("[LuaBridge] __gc: bridge Lua state is null, skipping...");
-		return 0;
+	if (!luaL_testudata(L, 1, "GodotObject")) {
+		return luaL_error(L, "[LuaBridge] bound method: expected a Godot object as self (use obj:method(...))");
 	}
+	Object* obj = check_wrapped_object(L, 1);
 	
-	try {
-		// First, check if this is a ResourceUserData by checking the size
-		void* userdata_ptr = lua_touserdata(L, 1);
-		if (!userdata_ptr) {
-			UtilityFunctions::print("[LuaBridge] __gc: userdata pointer is null");
-			return 0;
+	int argc = lua_gettop(L) - 1;
+	int declared_argc = (int)info->arg_types.size();
+	
+	// Errors are raised after the Variants below go out of scope, since lua_error longjmps
+	char error_buf[256];
+	error_buf[0] = '\0';
+	if (!info->is_vararg && argc > declared_argc) {
+		// Only vararg methods (emit_signal, call, rpc...) take arguments past the declared ones;
+		// fail before converting any
+		CharString method = String(info->name).utf8();
+		snprintf(error_buf, sizeof(error_buf), "[LuaBridge] %s: expected at most %d arguments, got %d",
+				method.get_data(), declared_argc, argc);
+	} else {
+		CallArguments args(argc);
+		for (int i = 0; i < argc; i++) {
+			Variant::Type type = i < declared_argc ? info->arg_types[i] : Variant::NIL;
+			bridge->lua_to_typed_variant(L, i + 2, type, args.argv[i]);
+			args.argp[i] = &args.argv[i];
 		}
 		
-		// Get the userdata size to determine the type
-		size_t userdata_size = lua_rawlen(L, 1);
-		UtilityFunctions::print("[LuaBridge] __gc: userdata size: " + String::num_int64(userdata_size));
+		Variant self = obj;
+		Variant result;
+		GDExtensionCallError call_error;
+		self.callp(info->name, args.argp, argc, result, call_error);
 		
-		// Check if this is ResourceUserData (should be sizeof(ResourceUserData))
-		if (userdata_size == sizeof(ResourceUserData)) {
-			ResourceUserData* resource_ud = static_cast<ResourceUserData*>(userdata_ptr);
-			if (resource_ud) {
-				UtilityFunctions::print("[LuaBridge] __gc: cleaning up ResourceUserData");
-				
-				// Remove from wrapper map first
-				Variant wrapper_key = Variant((int64_t)userdata_ptr);
-				std::map<Variant, Variant>::iterator it = bridge->wrapper_objects.find(wrapper_key);
-				if (it != bridge->wrapper_objects.end()) {
-					bridge->wrapper_objects.erase(it);
-					UtilityFunctions::print("[LuaBridge] __gc: removed from wrapper_objects map");
-				}
-				
-				// Clean up the resource reference
-				if (resource_ud->resource_ref.is_valid()) {
-					UtilityFunctions::print("[LuaBridge] __gc: resource_ref is valid, cleaning up");
-					resource_ud->resource_ref.~Ref<Resource>(); // Explicitly call destructor
-				} else {
-					UtilityFunctions::print("[LuaBridge] __gc: resource_ref is not valid, cleaning up anyway");
-					resource_ud->resource_ref.~Ref<Resource>(); // Explicitly call destructor
-				}
-				
-				resource_ud->obj_ptr = nullptr;
-				UtilityFunctions::print("[LuaBridge] __gc: ResourceUserData cleaned up");
-			}
-		} else if (userdata_size == sizeof(Object*)) {
-			// This is a regular Object** userdata
-			Object **ud = static_cast<Object **>(userdata_ptr);
-			if (ud && *ud) {
-				UtilityFunctions::print("[LuaBridge] __gc: cleaning up Object** structure, obj ptr: " + String::num_int64((int64_t)*ud));
-				
-				// Remove from wrapper map first
-				Variant wrapper_key = Variant((int64_t)userdata_ptr);
-				std::map<Variant, Variant>::iterator it = bridge->wrapper_objects.find(wrapper_key);
-				if (it != bridge->wrapper_objects.end()) {
-					bridge->wrapper_objects.erase(it);
-					UtilityFunctions::print("[LuaBridge] __gc: removed from wrapper_objects map");
-				}
-				
-				*ud = nullptr;
-				UtilityFunctions::print("[LuaBridge] __gc: Object** cleaned up");
-			}
-		} else {
-			UtilityFunctions::print("[LuaBridge] __gc: unknown userdata size: " + String::num_int64(userdata_size));
+		if (call_error.error == GDEXTENSION_CALL_OK) {
+			lua_settop(L, 0);
+			bridge->push_typed_return(L, info->return_type, result);
+			return 1;
 		}
-	} catch (...) {
-		UtilityFunctions::print("[LuaBridge] __gc: Exception during cleanup, continuing...");
+		
+		CharString method = String(info->name).utf8();
+		switch (call_error.error) {
+			case GDEXTENSION_CALL_ERROR_INVALID_ARGUMENT:
+				snprintf(error_buf, sizeof(error_buf), "[LuaBridge] %s: invalid argument #%d, expected %s",
+						method.get_data(), call_error.argument + 1,
+						Variant::get_type_name((Variant::Type)call_error.expected).utf8().get_data());
+				break;
+			case GDEXTENSION_CALL_ERROR_TOO_MANY_ARGUMENTS:
+			case GDEXTENSION_CALL_ERROR_TOO_FEW_ARGUMENTS:
+				snprintf(error_buf, sizeof(error_buf), "[LuaBridge] %s: expected %d arguments, got %d",
+						method.get_data(), call_error.expected, argc);
+				break;
+			default:
+				snprintf(error_buf, sizeof(error_buf), "[LuaBridge] %s: call failed (error %d)",
+						method.get_data(), (int)call_error.error);
+				break;
+		}
+	}
+	return luaL_error(L, "%s", error_buf);
+}
+
+int LuaBridge::lua_method_info_gc(lua_State* L) {
+	BoundMethodInfo* info = static_cast<BoundMethodInfo*>(lua_touserdata(L, 1));
+	if (info) {
+		info->~BoundMethodInfo();
 	}
 	return 0;
 }
 
 // Object wrapping implementation
 void LuaBridge::setup_godot_object_metatable() {
-	print_to_console("Setting up Godot object metatable...");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Setting up Godot object metatable...");
 	
 	// Register the metatable once
 	luaL_newmetatable(L, "GodotObject");
-	print_to_console("Created metatable 'GodotObject'");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Created metatable 'GodotObject'");
 
-	// __index: dynamically wrap method name as a closure
+	// __index: look up bound method closures in the per-class method cache
 	lua_pushstring(L, "__index");
 	// Push the LuaBridge instance as an upvalue
 	lua_pushlightuserdata(L, this);
-	lua_pushcclosure(L, [](lua_State* L) -> int {
-		// Get the LuaBridge instance from upvalue
-		LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
-		if (!bridge) {
-			UtilityFunctions::print("[LuaBridge] __index: No bridge instance");
-			lua_pushnil(L);
-			return 1;
-		}
-		
-		UtilityFunctions::print("[LuaBridge] __index metamethod called - ENTRY");
-		
-		// Get the userdata
-		Object* obj = nullptr;
-		
-		// Check if it's a userdata
-		if (lua_isuserdata(L, 1)) {
-			UtilityFunctions::print("[LuaBridge] Userdata found, checking type...");
-			
-			// Get the userdata pointer
-			void* userdata_ptr = lua_touserdata(L, 1);
-			if (!userdata_ptr) {
-				UtilityFunctions::print("[LuaBridge] Userdata pointer is null");
-				lua_pushnil(L);
-				return 1;
-			}
-			
-			// Try to get the metatable to determine the type
-			if (lua_getmetatable(L, 1)) {
-				UtilityFunctions::print("[LuaBridge] Got metatable from userdata");
-				// Check if it's our GodotObject metatable
-				// Get the GodotObject metatable for comparison
-				luaL_getmetatable(L, "GodotObject");
-				if (!lua_isnil(L, -1)) {
-					UtilityFunctions::print("[LuaBridge] Got GodotObject metatable for comparison");
-					if (lua_rawequal(L, -1, -2)) {
-						UtilityFunctions::print("[LuaBridge] Metatables match - this is our wrapped object");
-						// It's our wrapped object, try to get it from the wrapper map
-						Variant wrapper_key = Variant((int64_t)userdata_ptr);
-						
-						// Look up the actual object in the wrapper_objects map
-						std::map<Variant, Variant>::iterator it = bridge->wrapper_objects.find(wrapper_key);
-						if (it != bridge->wrapper_objects.end()) {
-							Variant wrapped_obj = it->second;
-							if (wrapped_obj.get_type() == Variant::OBJECT) {
-								obj = wrapped_obj.operator Object*();
-								UtilityFunctions::print("[LuaBridge] Found wrapped object in map, obj ptr: " + String::num_int64((int64_t)obj));
-							} else {
-								UtilityFunctions::print("[LuaBridge] Wrapped object is not an Object");
-								lua_pop(L, 2); // pop both metatables
-								lua_pushnil(L);
-								return 1;
-							}
-						} else {
-							UtilityFunctions::print("[LuaBridge] No wrapped object found in map for key: " + String::num_int64((int64_t)userdata_ptr));
-							lua_pop(L, 2); // pop both metatables
-							lua_pushnil(L);
-							return 1;
-						}
-						lua_pop(L, 2); // pop both metatables
-					} else {
-						UtilityFunctions::print("[LuaBridge] Metatables don't match - unknown metatable");
-						lua_pop(L, 2); // pop both metatables
-						lua_pushnil(L);
-						return 1;
-					}
-				} else {
-					UtilityFunctions::print("[LuaBridge] GodotObject metatable not found in registry");
-					lua_pop(L, 2); // pop both metatables
-					lua_pushnil(L);
-					return 1;
-				}
-			} else {
-				UtilityFunctions::print("[LuaBridge] No metatable found");
-				lua_pushnil(L);
-				return 1;
-			}
-		} else {
-			UtilityFunctions::print("[LuaBridge] Not userdata, pushing nil");
-			lua_pushnil(L);
-			return 1;
-		}
-
-		if (!obj) {
-			UtilityFunctions::print("[LuaBridge] Object is null, pushing nil");
-			lua_pushnil(L);
-			return 1;
-		}
+	lua_pushcclosure(L, godot_object_index, 1);
+	lua_settable(L, -3);
 
-		// Get the key
-		const char* key = lua_tostring(L, 2);
-		if (!key) {
-			UtilityFunctions::print("[LuaBridge] Key is not a string, pushing nil");
-			lua_pushnil(L);
-			return 1;
-		}
-
-		UtilityFunctions::print("[LuaBridge] Looking up key: " + String(key) + " on object: " + obj->get_class());
-
-		// Try to get the method/property
-		if (obj->has_method(key)) {
-			UtilityFunctions::print("[LuaBridge] Method found: " + String(key));
-			// Push method name as upvalue
-			lua_pushstring(L, key);
-			// Push a lightuserdata reference to the object as upvalue
-			lua_pushlightuserdata(L, obj);
-			// Closure: upvalue 1 = method name, upvalue 2 = object pointer
-			lua_pushcclosure(L, [](lua_State* L) -> int {
-				// Retrieve upvalues
-				const char* method_name = lua_tostring(L, lua_upvalueindex(1));
-				Object* obj = static_cast<Object*>(lua_touserdata(L, lua_upvalueindex(2)));
-				if (!obj || !method_name) {
-					UtilityFunctions::print("[LuaBridge] Bound method: missing object or method name");
-					lua_pushnil(L);
-					return 1;
-				}
-				UtilityFunctions::print("[LuaBridge] Bound method: " + String(method_name) + " on object: " + obj->get_class());
-				// Build argument array from Lua stack
-				Array args;
-				int num_args = lua_gettop(L);
-				for (int i = 1; i <= num_args; i++) {
-					if (lua_isstring(L, i)) args.push_back(String(lua_tostring(L, i)));
-					else if (lua_isnumber(L, i)) args.push_back(lua_tonumber(L, i));
-					else if (lua_isboolean(L, i)) args.push_back((bool)lua_toboolean(L, i));
-					else if (lua_isnil(L, i)) args.push_back(Variant());
-					else args.push_back(Variant());
-				}
-				// Call the method
-				Variant result;
-				try {
-					result = obj->callv(method_name, args);
-					UtilityFunctions::print("[LuaBridge] Bound method call completed");
-					UtilityFunctions::print("[LuaBridge] Method returned type: " + String::num_int64(result.get_type()));
-				} catch (...) {
-					UtilityFunctions::print("[LuaBridge] Bound method call exception");
-					lua_pushnil(L);
-					return 1;
-				}
-				// Convert result to Lua
-				UtilityFunctions::print("[LuaBridge] Converting result to Lua, type: " + String::num_int64(result.get_type()));
-				UtilityFunctions::print("[LuaBridge] Lua stack top before pushing result: " + String::num_int64(lua_gettop(L)));
-				
-				// Clear any existing values on the stack for this function call
-				lua_settop(L, 0);
-				UtilityFunctions::print("[LuaBridge] Lua stack cleared, top is now: " + String::num_int64(lua_gettop(L)));
-				
-				if (result.get_type() == Variant::BOOL) {
-					lua_pushboolean(L, bool(result));
-					UtilityFunctions::print("[LuaBridge] Pushed boolean result");
-				} else if (result.get_type() == Variant::INT) {
-					lua_pushinteger(L, int64_t(result));
-					UtilityFunctions::print("[LuaBridge] Pushed integer result");
-				} else if (result.get_type() == Variant::FLOAT) {
-					lua_pushnumber(L, double(result));
-					UtilityFunctions::print("[LuaBridge] Pushed float result");
-				} else if (result.get_type() == Variant::STRING) {
-					String str_result = String(result);
-					CharString utf8 = str_result.utf8();
-					lua_pushlstring(L, utf8.get_data(), utf8.length());
-					UtilityFunctions::print("[LuaBridge] Pushed string result: " + str_result);
-				} else if (result.get_type() == Variant::NIL) {
-					lua_pushnil(L);
-					UtilityFunctions::print("[LuaBridge] Pushed nil result");
-				} else {
-					lua_pushnil(L);
-					UtilityFunctions::print("[LuaBridge] Pushed nil for unknown type: " + String::num_int64(result.get_type()));
-				}
-				
-				UtilityFunctions::print("[LuaBridge] Lua stack top after pushing result: " + String::num_int64(lua_gettop(L)));
-				UtilityFunctions::print("[LuaBridge] About to return from method call function");
-				return 1;
-			}, 2);
-			UtilityFunctions::print("[LuaBridge] Bound method closure created for: " + String(key));
-		} else {
-			UtilityFunctions::print("[LuaBridge] Method not found: " + String(key));
-			lua_pushnil(L);
-		}
-
-		return 1;
-	}, 1);
-	lua_settable(L, -3);
-
-	print_to_console("Set __index metamethod");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Set __index metamethod");
 
 	// __newindex for property set
 	lua_pushstring(L, "__newindex");
 	lua_pushcfunction(L, lua_godot_object_newindex);
 	lua_settable(L, -3);
-	print_to_console("Set __newindex metamethod");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Set __newindex metamethod");
 
 	// __tostring for string representation
 	lua_pushstring(L, "__tostring");
 	lua_pushcfunction(L, lua_godot_object_tostring);
 	lua_settable(L, -3);
-	print_to_console("Set __tostring metamethod");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Set __tostring metamethod");
 
 	// __gc for garbage collection
 	lua_pushstring(L, "__gc");
 	lua_pushcfunction(L, lua_godot_object_gc);
 	lua_settable(L, -3);
-	print_to_console("Set __gc metamethod");
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Set __gc metamethod");
 
 	lua_pop(L, 1); // pop metatable
-	print_to_console("Godot object metatable setup complete");
+
+	// Lets scripts test cached object references without touching a freed object
+	lua_pushcfunction(L, lua_is_instance_valid);
+	lua_setglobal(L, "is_instance_valid");
+	bind_native<int64_t(Object*)>(this, "get_instance_id", &native_get_instance_id);
+
+	// Live wrappers by instance id; weak values so the cache never keeps a wrapper alive
+	lua_newtable(L);
+	lua_newtable(L);
+	lua_pushstring(L, "v");
+	lua_setfield(L, -2, "__mode");
+	lua_setmetatable(L, -2);
+	lua_setfield(L, LUA_REGISTRYINDEX, "godot_object_cache");
+
+	// Resolved method signatures are full userdata and need their destructor run
+	luaL_newmetatable(L, "GodotMethodInfo");
+	lua_pushcfunction(L, lua_method_info_gc);
+	lua_setfield(L, -2, "__gc");
+	lua_pop(L, 1);
+
+	// Method closures shared by all objects of the same class: cache[class_key][method] = closure
+	lua_newtable(L);
+	lua_setfield(L, LUA_REGISTRYINDEX, "godot_method_cache");
+
+	// Callables bound as upvalues of registered functions need their destructor run
+	luaL_newmetatable(L, "GodotCallable");
+	lua_pushcfunction(L, lua_registered_function_gc);
+	lua_setfield(L, -2, "__gc");
+	lua_pop(L, 1);
+
+	// Dictionary/Array proxies; the bridge upvalue is needed to convert elements
+	const char* container_metatables[] = { "GodotDictionary", "GodotArray" };
+	for (const char* metatable_name : container_metatables) {
+		luaL_newmetatable(L, metatable_name);
+		lua_pushlightuserdata(L, this);
+		lua_pushcclosure(L, lua_container_index, 1);
+		lua_setfield(L, -2, "__index");
+		lua_pushlightuserdata(L, this);
+		lua_pushcclosure(L, lua_container_newindex, 1);
+		lua_setfield(L, -2, "__newindex");
+		lua_pushlightuserdata(L, this);
+		lua_pushcclosure(L, lua_container_pairs, 1);
+		lua_setfield(L, -2, "__pairs");
+		lua_pushcfunction(L, lua_container_len);
+		lua_setfield(L, -2, "__len");
+		lua_pushcfunction(L, lua_container_tostring);
+		lua_setfield(L, -2, "__tostring");
+		lua_pushcfunction(L, lua_container_gc);
+		lua_setfield(L, -2, "__gc");
+		lua_pop(L, 1);
+	}
+
+	// Math value types and packed array views live beside GodotObject so every conversion path can produce them
+	lua_register_value_types(L);
+	lua_register_packed_arrays(L);
+
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_BRIDGE, "Godot object metatable setup complete");
 }
 
 void LuaBridge::push_godot_object_as_userdata(lua_State* L, Object* obj) {
-	UtilityFunctions::print("[LuaBridge] push_godot_object_as_userdata START - obj ptr: " + String::num_int64((int64_t)obj));
-	
 	if (!obj) {
-		UtilityFunctions::print("[LuaBridge] Object is null, pushing nil");
 		lua_pushnil(L);
 		return;
 	}
 
-	UtilityFunctions::print("[LuaBridge] Object is not null, checking if it's a Resource...");
+	// Reuse the live wrapper for this object so identity (==, table keys) holds in Lua
+	lua_Integer instance_id = (lua_Integer)obj->get_instance_id();
+	lua_getfield(L, LUA_REGISTRYINDEX, "godot_object_cache");
+	if (lua_rawgeti(L, -1, instance_id) == LUA_TUSERDATA) {
+		lua_remove(L, -2); // Remove the cache table
+		return;
+	}
+	lua_pop(L, 1);
 
-	// If the object is a Resource (or derived), use ResourceUserData to hold a strong reference
-	Ref<Resource> res = Object::cast_to<Resource>(obj);
-	if (res.is_valid()) {
-		UtilityFunctions::print("[LuaBridge] Object is a Resource, creating ResourceUserData...");
-		
-		ResourceUserData* ud = (ResourceUserData*)lua_newuserdata(L, sizeof(ResourceUserData));
-		UtilityFunctions::print("[LuaBridge] ResourceUserData allocated");
-		
-		ud->obj_ptr = obj;
-		// Use placement new to properly construct the Ref<Resource>
-		new (&ud->resource_ref) Ref<Resource>(res);
-		UtilityFunctions::print("[LuaBridge] resource_ref constructed with placement new");
-
-		// REGISTER THE OBJECT IN THE WRAPPER MAP
-		Variant wrapper_key = Variant((int64_t)ud);
-		wrapper_objects[wrapper_key] = Variant(obj);
-		object_wrappers[wrapper_key] = obj->get_class();
-		UtilityFunctions::print("[LuaBridge] Registered Resource in wrapper_objects with key: " + String::num_int64((int64_t)ud));
-
-		UtilityFunctions::print("[LuaBridge] Getting metatable...");
-		luaL_getmetatable(L, "GodotObject");
-		if (!lua_isnil(L, -1)) {
-			lua_setmetatable(L, -2);
-			UtilityFunctions::print("[LuaBridge] Metatable set successfully");
+	GodotObjectUserData* ud = static_cast<GodotObjectUserData*>(lua_newuserdatauv(L, sizeof(GodotObjectUserData), 1));
+	new (ud) GodotObjectUserData();
+	ud->instance_id = (uint64_t)instance_id;
+	ud->script_id = get_script_id(obj);
+
+	// If the object is a Resource (or derived), hold a strong reference
+	Resource* res = Object::cast_to<Resource>(obj);
+	if (res) {
+		ud->resource_ref = Ref<Resource>(res);
+	}
+
+	luaL_setmetatable(L, "GodotObject");
+	
+	// Attach the class method table so __index can hit the closure cache directly
+	push_method_table(L, obj);
+	lua_setiuservalue(L, -2, 1);
+
+	lua_pushvalue(L, -1);
+	lua_rawseti(L, -3, instance_id);
+	lua_remove(L, -2); // Remove the cache table
+	
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_CONVERSION, "Wrapped " + obj->get_class() + " (id " + String::num_uint64(ud->instance_id) + ")");
+}
+
+void LuaBridge::push_container_proxy(lua_State* L, const Variant& container) {
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_newuserdatauv(L, sizeof(GodotContainerUserData), 0));
+	new (ud) GodotContainerUserData();
+	ud->container = container;
+	luaL_setmetatable(L, container.get_type() == Variant::DICTIONARY ? "GodotDictionary" : "GodotArray");
+}
+
+int LuaBridge::lua_container_index(lua_State* L) {
+	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, 1));
+	if (ud->container.get_type() == Variant::ARRAY) {
+		Array arr = ud->container;
+		lua_Integer i = lua_isinteger(L, 2) ? lua_tointeger(L, 2) : 0;
+		if (i >= 1 && i <= arr.size()) {
+			bridge->godot_to_lua(L, arr[i - 1]);
 		} else {
-			lua_pop(L, 1);
-			UtilityFunctions::print("Warning: GodotObject metatable not found for ResourceUserData");
+			lua_pushnil(L);
 		}
+		return 1;
+	}
+	Dictionary dict = ud->container;
+	bridge->godot_to_lua(L, dict.get(bridge->lua_to_godot(L, 2), Variant()));
+	return 1;
+}
 
-		UtilityFunctions::print("[LuaBridge] About to return wrapped Resource to Lua...");
-		
-		// Safety check - make sure the resource is still valid
-		if (res.is_valid()) {
-			UtilityFunctions::print("[LuaBridge] Resource is still valid, getting class...");
-			UtilityFunctions::print("[LuaBridge] Wrapped Resource: " + res->get_class() + ", obj ptr: " + String::num_int64((int64_t)obj));
+int LuaBridge::lua_container_newindex(lua_State* L) {
+	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, 1));
+	bool out_of_range = false;
+	lua_Integer size = 0;
+	if (ud->container.get_type() == Variant::ARRAY) {
+		Array arr = ud->container;
+		lua_Integer i = lua_isinteger(L, 2) ? lua_tointeger(L, 2) : 0;
+		if (i >= 1 && i <= arr.size()) {
+			arr[i - 1] = bridge->lua_to_godot(L, 3);
+		} else if (i == arr.size() + 1) {
+			arr.append(bridge->lua_to_godot(L, 3));
 		} else {
-			UtilityFunctions::print("[LuaBridge] WARNING: Resource became invalid after metatable setup!");
+			out_of_range = true;
+			size = arr.size();
 		}
 	} else {
-		UtilityFunctions::print("[LuaBridge] Object is not a Resource, creating Object** userdata...");
-		
-		// For non-Resource objects, just store the pointer
-		Object** ud = (Object**)lua_newuserdata(L, sizeof(Object*));
-		UtilityFunctions::print("[LuaBridge] Object** userdata allocated");
-		
-		*ud = obj;
-		UtilityFunctions::print("[LuaBridge] Object** userdata initialized");
-
-		// REGISTER THE OBJECT IN THE WRAPPER MAP
-		Variant wrapper_key = Variant((int64_t)ud);
-		wrapper_objects[wrapper_key] = Variant(obj);
-		object_wrappers[wrapper_key] = obj->get_class();
-		UtilityFunctions::print("[LuaBridge] Registered Object in wrapper_objects with key: " + String::num_int64((int64_t)ud));
-
-		UtilityFunctions::print("[LuaBridge] Getting metatable...");
-		luaL_getmetatable(L, "GodotObject");
-		if (!lua_isnil(L, -1)) {
-			lua_setmetatable(L, -2);
-			UtilityFunctions::print("[LuaBridge] Metatable set successfully");
+		Dictionary dict = ud->container;
+		Variant key = bridge->lua_to_godot(L, 2);
+		if (lua_isnil(L, 3)) {
+			dict.erase(key);
 		} else {
-			lua_pop(L, 1);
-			UtilityFunctions::print("Warning: GodotObject metatable not found for Object*");
+			dict[key] = bridge->lua_to_godot(L, 3);
 		}
+		return 0;
+	}
+	if (out_of_range) {
+		// Raised after the Godot locals above are destroyed
+		return luaL_error(L, "GodotArray index out of range (size %I)", size);
+	}
+	return 0;
+}
 
-		UtilityFunctions::print("[LuaBridge] Wrapped Object: " + obj->get_class() + ", obj ptr: " + String::num_int64((int64_t)obj));
+int LuaBridge::lua_container_len(lua_State* L) {
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, 1));
+	if (ud->container.get_type() == Variant::ARRAY) {
+		lua_pushinteger(L, ((Array)ud->container).size());
+	} else {
+		lua_pushinteger(L, ((Dictionary)ud->container).size());
 	}
-	
-	UtilityFunctions::print("[LuaBridge] push_godot_object_as_userdata COMPLETED");
+	return 1;
+}
+
+int LuaBridge::lua_container_pairs(lua_State* L) {
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, 1));
+	// Iterator upvalues: bridge, proxy, position and, for Dictionaries, a snapshot of the keys
+	lua_pushvalue(L, lua_upvalueindex(1));
+	lua_pushvalue(L, 1);
+	lua_pushinteger(L, 0);
+	if (ud->container.get_type() == Variant::DICTIONARY) {
+		push_container_proxy(L, ((Dictionary)ud->container).keys());
+		lua_pushcclosure(L, lua_container_next, 4);
+	} else {
+		lua_pushcclosure(L, lua_container_next, 3);
+	}
+	lua_pushvalue(L, 1);
+	lua_pushnil(L);
+	return 3;
+}
+
+int LuaBridge::lua_container_next(lua_State* L) {
+	LuaBridge* bridge = static_cast<LuaBridge*>(lua_touserdata(L, lua_upvalueindex(1)));
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, lua_upvalueindex(2)));
+	lua_Integer position = lua_tointeger(L, lua_upvalueindex(3));
+
+	if (ud->container.get_type() == Variant::ARRAY) {
+		Array arr = ud->container;
+		if (position >= arr.size()) {
+			lua_pushnil(L);
+			return 1;
+		}
+		lua_pushinteger(L, position + 1);
+		bridge->godot_to_lua(L, arr[position]);
+	} else {
+		GodotContainerUserData* keys_ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, lua_upvalueindex(4)));
+		Array keys = keys_ud->container;
+		if (position >= keys.size()) {
+			lua_pushnil(L);
+			return 1;
+		}
+		Dictionary dict = ud->container;
+		bridge->godot_to_lua(L, keys[position]);
+		bridge->godot_to_lua(L, dict.get(keys[position], Variant()));
+	}
+	lua_pushinteger(L, position + 1);
+	lua_replace(L, lua_upvalueindex(3));
+	return 2;
+}
+
+int LuaBridge::lua_container_tostring(lua_State* L) {
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, 1));
+	if (ud->container.get_type() == Variant::ARRAY) {
+		lua_pushfstring(L, "GodotArray(%I)", (lua_Integer)((Array)ud->container).size());
+	} else {
+		lua_pushfstring(L, "GodotDictionary(%I)", (lua_Integer)((Dictionary)ud->container).size());
+	}
+	return 1;
+}
+
+int LuaBridge::lua_container_gc(lua_State* L) {
+	GodotContainerUserData* ud = static_cast<GodotContainerUserData*>(lua_touserdata(L, 1));
+	ud->~GodotContainerUserData();
+	return 0;
 }
 
 Array LuaBridge::lua_to_variant_array(lua_State* L, int start) {
 	Array args;
 	int num_args = lua_gettop(L);
 	
-	UtilityFunctions::print("[LuaBridge] lua_to_variant_array called with " + String::num_int64(num_args) + " arguments");
-	UtilityFunctions::print("[LuaBridge] lua_to_variant_array start parameter: " + String::num_int64(start));
-	
 	// Safety check for valid start index
 	if (start < 1 || start > num_args) {
-		UtilityFunctions::print("[LuaBridge] lua_to_variant_array: Invalid start index " + String::num_int64(start) + " for " + String::num_int64(num_args) + " arguments");
 		return args;
 	}
 	
-	// Debug: Check what type the first argument is
-	if (num_args >= 1) {
-		int type = lua_type(L, 1);
-		const char* type_name = lua_typename(L, type);
-		UtilityFunctions::print("[LuaBridge] First argument type: " + String(type_name));
-		UtilityFunctions::print("[LuaBridge] Is table check: " + String(lua_istable(L, 1) ? "true" : "false"));
-	}
-	
 	// Check if we have exactly one argument and it's a table
 	if (num_args == 1 && lua_istable(L, 1)) {
 		// Convert the Lua table to a Godot Dictionary and pass it as a single argument
 		try {
 			Variant dict = lua_to_godot(L, 1);
 			args.append(dict);
-			UtilityFunctions::print("[LuaBridge] Converting Lua table to Dictionary argument");
-			UtilityFunctions::print("[LuaBridge] Dictionary type: " + String::num_int64(dict.get_type()));
-			if (dict.get_type() == Variant::DICTIONARY) {
-				Dictionary d = dict;
-				UtilityFunctions::print("[LuaBridge] Dictionary has " + String::num_int64(d.size()) + " keys");
-			}
+			LUA_LOG_DEBUG(log_filter, LUA_LOG_CONVERSION, "Converted single table argument to " + Variant::get_type_name(dict.get_type()));
 		} catch (...) {
-			UtilityFunctions::print("[LuaBridge] lua_to_variant_array: Exception occurred while converting table, using empty dictionary");
+			LUA_LOG_WARN(log_filter, LUA_LOG_CONVERSION, "lua_to_variant_array: Exception occurred while converting table, using empty dictionary");
 			args.append(Dictionary());
 		}
 	} else {
@@ -2236,6 +2898,30 @@ Array LuaBridge::lua_to_variant_array(lua_State* L, int start) {
 	return args;
 }
 
+Variant LuaBridge::lua_userdata_to_variant(lua_State* L, int index) {
+	Variant value;
+	if (lua_to_value_type(L, index, value) || lua_to_packed_array(L, index, value)) {
+		return value;
+	}
+	GodotContainerUserData* container = static_cast<GodotContainerUserData*>(luaL_testudata(L, index, "GodotDictionary"));
+	if (!container) {
+		container = static_cast<GodotContainerUserData*>(luaL_testudata(L, index, "GodotArray"));
+	}
+	if (container) {
+		// Hand back the shared container, not a copy
+		return container->container;
+	}
+	GodotObjectUserData* ud = static_cast<GodotObjectUserData*>(luaL_testudata(L, index, "GodotObject"));
+	if (!ud) {
+		return Variant();
+	}
+	if (ud->resource_ref.is_valid()) {
+		return ud->resource_ref;
+	}
+	// A freed object converts to null
+	return Variant(ObjectDB::get_instance(ud->instance_id));
+}
+
 Variant LuaBridge::lua_to_variant(lua_State* L, int index) {
 	switch (lua_type(L, index)) {
 		case LUA_TSTRING:
@@ -2249,82 +2935,441 @@ Variant LuaBridge::lua_to_variant(lua_State* L, int index) {
 			}
 		case LUA_TBOOLEAN:
 			return lua_toboolean(L, index);
-		case LUA_TUSERDATA: {
-			void* userdata_ptr = lua_touserdata(L, index);
-			Variant wrapper_key = Variant((int64_t)userdata_ptr);
-			return wrapper_key;
-		}
+		case LUA_TUSERDATA:
+			return lua_userdata_to_variant(L, index);
 		default:
 			return Variant();  // nil or unsupported
 	}
 }
 
 void LuaBridge::push_variant_to_lua(lua_State* L, const Variant& value) {
-	switch (value.get_type()) {
-		case Variant::BOOL:
-			lua_pushboolean(L, bool(value));
-			break;
-		case Variant::INT:
-			lua_pushinteger(L, int64_t(value));
-			break;
-		case Variant::FLOAT:
-			lua_pushnumber(L, double(value));
-			break;
-		case Variant::STRING:
-			lua_pushstring(L, String(value).utf8().get_data());
-			break;
-		case Variant::DICTIONARY: {
-			Dictionary dict = value;
-			lua_newtable(L);
-			
-			// Get all keys and values
-			Array keys = dict.keys();
-			Array values = dict.values();
-			
-			for (int i = 0; i < keys.size(); i++) {
-				Variant key = keys[i];
-				Variant val = values[i];
-				
-				// Push the key
-				push_variant_to_lua(L, key);
-				
-				// Push the value
-				push_variant_to_lua(L, val);
-				
-				// Set the key-value pair in the table
-				lua_settable(L, -3);
+	godot_to_lua(L, value);
+}
+
+void LuaBridge::set_verbose_logging(bool enabled) {
+	log_filter.level = enabled ? LUA_LOG_LEVEL_DEBUG : LUA_LOG_LEVEL_INFO;
+}
+
+bool LuaBridge::is_verbose_logging() const {
+	return log_filter.level >= LUA_LOG_LEVEL_DEBUG;
+}
+
+void LuaBridge::set_log_buffering(bool enabled) {
+	if (enabled == LuaLog::is_buffered()) return;
+	if (!enabled) {
+		flush_logs();
+	}
+	LuaLog::set_buffered(enabled, log_buffer_capacity);
+}
+
+bool LuaBridge::is_log_buffering() const {
+	return LuaLog::is_buffered();
+}
+
+void LuaBridge::set_log_buffer_capacity(int capacity) {
+	log_buffer_capacity = (uint32_t)MAX(capacity, 2);
+	if (LuaLog::is_buffered()) {
+		// Reallocate the ring; queued entries are delivered first
+		flush_logs();
+		LuaLog::set_buffered(true, log_buffer_capacity);
+	}
+}
+
+int LuaBridge::get_log_buffer_capacity() const {
+	LuaLogRing* ring = LuaLog::get_ring();
+	return ring ? (int)ring->get_capacity() : (int)log_buffer_capacity;
+}
+
+int64_t LuaBridge::get_dropped_log_count() const {
+	LuaLogRing* ring = LuaLog::get_ring();
+	return ring ? (int64_t)ring->get_dropped() : 0;
+}
+
+int LuaBridge::flush_logs() {
+	LuaLogRing* ring = LuaLog::get_ring();
+	if (!ring) return 0;
+	
+	// Console lines are batched into a single print; Lua prints with a registered
+	// GDScript handler are delivered one call per line on this (main) thread
+	String console_batch;
+	int count = 0;
+	LuaLogRing::Entry entry;
+	while (count < (int)ring->get_capacity() && ring->pop(entry)) {
+		count++;
+		if (entry.is_lua_print) {
+			LuaBridge* source = Object::cast_to<LuaBridge>(ObjectDB::get_instance(entry.source_id));
+			if (source) {
+				auto it = source->registered_functions.find("print");
+				if (it != source->registered_functions.end()) {
+					it->second.call(entry.message);
+					continue;
+				}
 			}
-			break;
+			console_batch += (console_batch.is_empty() ? "[Lua] " : "\n[Lua] ") + entry.message;
+		} else if (entry.level <= LUA_LOG_LEVEL_WARNING) {
+			LuaLog::write_direct(entry.level, entry.message);
+		} else {
+			console_batch += (console_batch.is_empty() ? "[LuaBridge] " : "\n[LuaBridge] ") + entry.message;
 		}
-		case Variant::ARRAY: {
-			Array arr = value;
-			lua_newtable(L);
-			for (int i = 0; i < arr.size(); i++) {
-				// Lua arrays are 1-indexed
-				lua_pushinteger(L, i + 1);
-				push_variant_to_lua(L, arr[i]);
-				lua_settable(L, -3);
-			}
-			break;
+	}
+	if (!console_batch.is_empty()) {
+		UtilityFunctions::print(console_batch);
+	}
+	return count;
+}
+
+void LuaBridge::set_log_categories(int categories) {
+	log_filter.categories = (uint32_t)categories;
+}
+
+int LuaBridge::get_log_categories() const {
+	return (int)log_filter.categories;
+}
+
+void LuaBridge::set_conversion_max_depth(int depth) {
+	conversion_max_depth = depth > 0 ? depth : 1;
+}
+
+int LuaBridge::get_conversion_max_depth() const {
+	return conversion_max_depth;
+}
+
+void LuaBridge::set_conversion_max_elements(int64_t max_elements) {
+	conversion_max_elements = max_elements > 0 ? max_elements : 0;
+}
+
+int64_t LuaBridge::get_conversion_max_elements() const {
+	return conversion_max_elements;
+}
+
+void LuaBridge::set_table_proxies_enabled(bool enabled) {
+	table_proxies_enabled = enabled;
+}
+
+bool LuaBridge::is_table_proxies_enabled() const {
+	return table_proxies_enabled;
+}
+
+void LuaBridge::set_container_proxies_enabled(bool enabled) {
+	container_proxies_enabled = enabled;
+}
+
+bool LuaBridge::is_container_proxies_enabled() const {
+	return container_proxies_enabled;
+}
+
+Dictionary LuaBridge::get_memory_stats() const {
+	if (!allocator) {
+		return Dictionary();
+	}
+	Dictionary stats = allocator->get_stats();
+	Dictionary mods;
+	for (size_t i = 0; i < mod_memory_owners.size(); i++) {
+		Dictionary usage;
+		usage["bytes_in_use"] = (int64_t)allocator->get_owner_bytes((uint32_t)(i + 1));
+		usage["memory_limit"] = (int64_t)allocator->get_owner_limit((uint32_t)(i + 1));
+		mods[mod_memory_owners[i].mod_name] = usage;
+	}
+	stats["mods"] = mods;
+	return stats;
+}
+
+int64_t LuaBridge::get_mod_memory_usage(String mod_name) const {
+	if (!allocator) {
+		return 0;
+	}
+	for (size_t i = 0; i < mod_memory_owners.size(); i++) {
+		if (mod_memory_owners[i].mod_name == mod_name) {
+			return (int64_t)allocator->get_owner_bytes((uint32_t)(i + 1));
 		}
-		case Variant::OBJECT: {
-			Object *obj = Object::cast_to<Object>(value);
-			if (obj) {
-				push_godot_object_as_userdata(L, obj);
-			} else {
-				lua_pushnil(L);
-			}
+	}
+	return 0;
+}
+
+void LuaBridge::set_memory_limits_enforced(bool enforced) {
+	memory_limits_enforced = enforced;
+	if (allocator) {
+		allocator->set_limits_enforced(enforced);
+	}
+}
+
+bool LuaBridge::is_memory_limits_enforced() const {
+	return memory_limits_enforced;
+}
+
+uint32_t LuaBridge::get_mod_memory_owner(const String& mod_name, const String& mod_dir, int64_t memory_limit) {
+	// Functions defined by the mod's scripts carry their file path as chunk name
+	CharString source_prefix = get_mod_source_prefix(mod_dir).utf8();
+	for (size_t i = 0; i < mod_memory_owners.size(); i++) {
+		if (mod_memory_owners[i].mod_name == mod_name) {
+			mod_memory_owners[i].source_prefix = source_prefix;
+			allocator->set_owner_limit((uint32_t)(i + 1), (size_t)memory_limit);
+			return (uint32_t)(i + 1);
+		}
+	}
+	ModMemoryOwner owner;
+	owner.mod_name = mod_name;
+	owner.source_prefix = source_prefix;
+	mod_memory_owners.push_back(owner);
+	return allocator->create_owner((size_t)memory_limit);
+}
+
+uint32_t LuaBridge::get_function_memory_owner(int index) {
+	uint32_t owner = allocator->get_current_owner();
+	if (mod_memory_owners.empty() || !lua_isfunction(L, index)) {
+		return owner;
+	}
+	lua_Debug ar;
+	lua_pushvalue(L, index);
+	if (!lua_getinfo(L, ">S", &ar)) {
+		return owner;
+	}
+	// C functions and chunks loaded from strings run on behalf of their caller
+	uint32_t function_owner = find_mod_memory_owner(ar.source);
+	return function_owner != 0 ? function_owner : owner;
+}
+
+uint32_t LuaBridge::find_mod_memory_owner(const char* source) const {
+	if (!source || source[0] != '@') {
+		return 0;
+	}
+	for (size_t i = 0; i < mod_memory_owners.size(); i++) {
+		const CharString& prefix = mod_memory_owners[i].source_prefix;
+		if (strncmp(source, prefix.get_data(), prefix.length()) == 0) {
+			return (uint32_t)(i + 1);
+		}
+	}
+	return 0;
+}
+
+void LuaBridge::emit_memory_budget_events() {
+	uint32_t owner = 0;
+	while (allocator && allocator->take_budget_event(owner)) {
+		if (owner == 0 || owner > mod_memory_owners.size()) {
+			continue;
+		}
+		const String mod_name = mod_memory_owners[owner - 1].mod_name;
+		int64_t bytes_in_use = (int64_t)allocator->get_owner_bytes(owner);
+		int64_t memory_limit = (int64_t)allocator->get_owner_limit(owner);
+		LUA_LOG_WARN(log_filter, LUA_LOG_MODS, "Mod " + mod_name + " is over its memory budget: " + String::num_int64(bytes_in_use) + " of " + String::num_int64(memory_limit) + " bytes");
+		emit_signal("mod_over_budget", mod_name, bytes_in_use, memory_limit);
+	}
+}
+
+void LuaBridge::set_gc_frame_budget(int64_t usec) {
+	bool was_frame_driven = is_gc_frame_driven();
+	gc_frame_budget_usec = usec < 0 ? 0 : usec;
+	update_gc_collector_state(was_frame_driven);
+}
+
+int64_t LuaBridge::get_gc_frame_budget() const {
+	return gc_frame_budget_usec;
+}
+
+void LuaBridge::set_gc_mode(int mode) {
+	if (mode != GC_INCREMENTAL && mode != GC_GENERATIONAL) {
+		log_error("Invalid GC mode: " + String::num_int64(mode));
+		return;
+	}
+	gc_mode = mode;
+	if (!L) {
+		return;
+	}
+	// Switching to generational mode runs a full collection; zeros keep the minor and major multipliers
+	if (mode == GC_GENERATIONAL) {
+		lua_gc(L, LUA_GCGEN, 0, 0);
+	} else {
+		lua_gc(L, LUA_GCINC, gc_pause, gc_step_multiplier, 0);
+	}
+	gc_cycle_in_progress = false;
+	gc_next_cycle_kb = 0;
+}
+
+int LuaBridge::get_gc_mode() const {
+	return gc_mode;
+}
+
+void LuaBridge::set_gc_adaptive(bool enabled) {
+	bool was_frame_driven = is_gc_frame_driven();
+	gc_adaptive = enabled;
+	gc_window = GCWindow();
+	gc_windows_since_mode_switch = 0;
+	update_gc_collector_state(was_frame_driven);
+}
+
+bool LuaBridge::is_gc_adaptive() const {
+	return gc_adaptive;
+}
+
+void LuaBridge::set_gc_target_frame_fraction(float fraction) {
+	gc_target_frame_fraction = CLAMP(fraction, 0.001f, 0.5f);
+}
+
+float LuaBridge::get_gc_target_frame_fraction() const {
+	return gc_target_frame_fraction;
+}
+
+Dictionary LuaBridge::get_gc_stats() const {
+	Dictionary stats;
+	stats["frame_budget_usec"] = gc_frame_budget_usec;
+	stats["last_frame_usec"] = (int64_t)gc_last_frame_usec;
+	stats["max_frame_usec"] = (int64_t)gc_max_frame_usec;
+	stats["total_usec"] = (int64_t)gc_total_usec;
+	stats["last_frame_steps"] = gc_last_frame_steps;
+	stats["cycles_completed"] = gc_cycles_completed;
+	stats["memory_kb"] = L ? (int64_t)lua_gc(L, LUA_GCCOUNT) : (int64_t)0;
+	stats["mode"] = gc_mode;
+	stats["adaptive"] = gc_adaptive;
+	stats["pause"] = gc_pause;
+	stats["step_multiplier"] = gc_step_multiplier;
+	stats["allocation_rate_kb_per_sec"] = gc_allocation_rate_kb_per_sec;
+	stats["frame_fraction"] = gc_frame_fraction;
+	return stats;
+}
+
+void LuaBridge::update_gc_collector_state(bool was_frame_driven) {
+	bool frame_driven = is_gc_frame_driven();
+	if (!L || was_frame_driven == frame_driven) {
+		return;
+	}
+	if (frame_driven) {
+		// From now on the collector only runs from call_on_update()
+		lua_gc(L, LUA_GCSTOP);
+		gc_cycle_in_progress = false;
+		gc_next_cycle_kb = 0;
+	} else {
+		lua_gc(L, LUA_GCRESTART);
+	}
+}
+
+void LuaBridge::run_frame_gc(float delta) {
+	uint64_t frame_usec = delta > 0.0f ? (uint64_t)(delta * 1000000.0f) : 0;
+	uint64_t budget_usec = (uint64_t)gc_frame_budget_usec;
+	if (budget_usec == 0) {
+		// Adaptive tuning without an explicit budget: the target share of this frame
+		budget_usec = MAX((uint64_t)(frame_usec * gc_target_frame_fraction), (uint64_t)GC_MIN_ADAPTIVE_BUDGET_USEC);
+	}
+	step_gc_within_budget(budget_usec);
+	if (gc_adaptive) {
+		tune_gc(frame_usec, budget_usec);
+	}
+}
+
+void LuaBridge::step_gc_within_budget(uint64_t budget_usec) {
+	Time* time = Time::get_singleton();
+	uint64_t start = time->get_ticks_usec();
+	gc_last_frame_usec = 0;
+	gc_last_frame_steps = 0;
+
+	// Pace cycles the way Lua's own pause does: a new cycle starts once the heap has
+	// grown by the pause (incremental) or minor multiplier (generational) since the last one
+	if (!gc_cycle_in_progress) {
+		if (lua_gc(L, LUA_GCCOUNT) < gc_next_cycle_kb) {
+			return;
+		}
+		gc_cycle_in_progress = true;
+	}
+
+	uint64_t deadline = start + budget_usec;
+	do {
+		gc_last_frame_steps++;
+		// A generational step is a whole minor collection, so it always ends the cycle
+		if (lua_gc(L, LUA_GCSTEP, 0) || gc_mode == GC_GENERATIONAL) {
+			int growth = gc_mode == GC_GENERATIONAL ? 100 + GC_GENERATIONAL_MINOR_MULTIPLIER : gc_pause;
+			gc_next_cycle_kb = (int64_t)lua_gc(L, LUA_GCCOUNT) * growth / 100;
+			gc_cycle_in_progress = false;
+			gc_cycles_completed++;
 			break;
 		}
-		default:
-			lua_pushnil(L);
+	} while (time->get_ticks_usec() < deadline);
+
+	gc_last_frame_usec = time->get_ticks_usec() - start;
+	gc_total_usec += gc_last_frame_usec;
+	if (gc_last_frame_usec > gc_max_frame_usec) {
+		gc_max_frame_usec = gc_last_frame_usec;
 	}
-} 
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "GC frame: " + String::num_int64(gc_last_frame_steps) + " steps in " + String::num_int64((int64_t)gc_last_frame_usec) + " usec");
+}
 
-void LuaBridge::set_verbose_logging(bool enabled) {
-	verbose_logging = enabled;
+void LuaBridge::tune_gc(uint64_t frame_usec, uint64_t budget_usec) {
+	GCWindow& window = gc_window;
+	uint64_t allocated = allocator->get_bytes_allocated_total();
+	if (window.frames == 0) {
+		window.allocated_at_start = allocated;
+	}
+	window.frames++;
+	window.frame_usec += frame_usec;
+	window.gc_usec += gc_last_frame_usec;
+	window.steps += (uint64_t)gc_last_frame_steps;
+	// A single step that blew the budget means steps are too coarse for it
+	if (gc_last_frame_steps == 1 && gc_last_frame_usec > budget_usec) {
+		window.overruns++;
+	}
+	if (window.frame_usec < GC_TUNING_WINDOW_USEC) {
+		return;
+	}
+
+	double seconds = window.frame_usec / 1000000.0;
+	double allocated_kb = (allocated - window.allocated_at_start) / 1024.0;
+	double heap_kb = MAX((double)lua_gc(L, LUA_GCCOUNT), 1.0);
+	gc_allocation_rate_kb_per_sec = allocated_kb / seconds;
+	gc_frame_fraction = (double)window.gc_usec / (double)window.frame_usec;
+	// How many times the heap was allocated over in the window: high churn means most objects die young
+	double churn = allocated_kb / heap_kb;
+	gc_windows_since_mode_switch++;
+
+	if (gc_mode == GC_INCREMENTAL) {
+		// Over target: let the heap grow further between cycles. Well under: collect sooner to save memory.
+		if (gc_frame_fraction > gc_target_frame_fraction) {
+			gc_pause = MIN(gc_pause + 25, GC_MAX_PAUSE);
+		} else if (gc_frame_fraction < gc_target_frame_fraction * 0.5) {
+			gc_pause = MAX(gc_pause - 10, GC_MIN_PAUSE);
+		}
+		// Keep a basic step comfortably inside the budget without paying a clock read for every sliver of work
+		if (window.overruns * 4 > window.frames) {
+			gc_step_multiplier = MAX(gc_step_multiplier / 2, GC_MIN_STEP_MULTIPLIER);
+		} else if (window.overruns == 0 && window.steps > window.frames * 64) {
+			gc_step_multiplier = MIN(gc_step_multiplier * 2, GC_MAX_STEP_MULTIPLIER);
+		}
+		lua_gc(L, LUA_GCINC, gc_pause, gc_step_multiplier, 0);
+
+		if (churn > GC_GENERATIONAL_CHURN && gc_windows_since_mode_switch > GC_MODE_SWITCH_COOLDOWN) {
+			LUA_LOG_INFO(log_filter, LUA_LOG_GC, "Adaptive GC: switching to generational mode (" + String::num(gc_allocation_rate_kb_per_sec, 0) + " KB/s, heap " + String::num(heap_kb, 0) + " KB)");
+			set_gc_mode(GC_GENERATIONAL);
+			gc_windows_since_mode_switch = 0;
+		}
+	} else if ((gc_frame_fraction > gc_target_frame_fraction * 2.0 || churn < GC_INCREMENTAL_CHURN) &&
+			gc_windows_since_mode_switch > GC_MODE_SWITCH_COOLDOWN) {
+		// Minor collections cost too much (a large, long-lived heap) or garbage no longer dies young
+		LUA_LOG_INFO(log_filter, LUA_LOG_GC, "Adaptive GC: switching to incremental mode (" + String::num(gc_allocation_rate_kb_per_sec, 0) + " KB/s, heap " + String::num(heap_kb, 0) + " KB)");
+		set_gc_mode(GC_INCREMENTAL);
+		gc_windows_since_mode_switch = 0;
+	}
+
+	LUA_LOG_DEBUG(log_filter, LUA_LOG_GC, "Adaptive GC: " + String::num(gc_frame_fraction * 100.0, 2) + "% of frame time, pause " + String::num_int64(gc_pause) + ", step multiplier " + String::num_int64(gc_step_multiplier));
+	gc_window = GCWindow();
 }
 
-bool LuaBridge::is_verbose_logging() const {
-	return verbose_logging;
+void LuaBridge::set_bytecode_cache_enabled(bool enabled) {
+	bytecode_cache_enabled = enabled;
+}
+
+bool LuaBridge::is_bytecode_cache_enabled() const {
+	return bytecode_cache_enabled;
+}
+
+int LuaBridge::clear_bytecode_cache() {
+	int removed = LuaChunkCache::clear();
+	LUA_LOG_INFO(log_filter, LUA_LOG_MODS, "Cleared bytecode cache: " + String::num_int64(removed) + " entries");
+	return removed;
+}
+
+Dictionary LuaBridge::get_bytecode_cache_stats() const {
+	Dictionary stats;
+	stats["enabled"] = bytecode_cache_enabled;
+	stats["hits"] = (int64_t)bytecode_cache_stats.hits;
+	stats["misses"] = (int64_t)bytecode_cache_stats.misses;
+	stats["write_failures"] = (int64_t)bytecode_cache_stats.write_failures;
+	stats["cache_dir"] = String(LuaChunkCache::CACHE_DIR);
+	return stats;
 }
\ No newline at end of file
@@ -19,8 +19,13 @@
 #include <map>
 #include <vector>
 
+#include "lua_chunk_cache.h"
+#include "lua_log.h"
+
 // Forward declarations
 struct lua_State;
+struct BoundMethodInfo;
+struct LuaConversionContext;
 
 namespace godot {
 
@@ -28,20 +33,49 @@ class SceneTree;
 class Engine;
 
 class LuaBridge;
+class LuaAllocator;
 
 class LuaBridge : public RefCounted {
     GDCLASS(LuaBridge, RefCounted)
 
+public:
+    enum GCMode {
+        GC_INCREMENTAL = 0,
+        GC_GENERATIONAL = 1,
+    };
+
+    friend class LuaTable;
+    friend class LuaCallable;
+
 private:
     lua_State* L = nullptr;
+    LuaAllocator* allocator = nullptr;  // Pooled allocator backing L, freed after lua_close
     bool sandboxed = true;
-    bool verbose_logging = false;  // Control verbose logging
+    LuaLogFilter log_filter;  // Level and categories of this bridge's diagnostics
+    uint32_t log_buffer_capacity = 4096;  // Entries in the log ring when buffering is enabled
+    int conversion_max_depth = 64;  // Table nesting allowed when converting Lua values to Godot
+    int64_t conversion_max_elements = 1000000;  // Table entries allowed per conversion, 0 for no limit
+    bool table_proxies_enabled = false;  // Return tables to GDScript as LuaTable instead of deep copies
+    bool container_proxies_enabled = false;  // Pass Dictionary/Array into Lua as shared proxies instead of tables
+    bool bytecode_cache_enabled = true;  // Load scripts through the compiled chunk cache in user://
+    LuaChunkCache::Stats bytecode_cache_stats;
+    bool lua_warnings_enabled = true;  // Toggled by warn("@off") / warn("@on")
+    String pending_lua_warning;  // Pieces of a multi-part warn() message
     String last_error = "";
     bool is_cleaning_up = false;  // Flag to prevent __gc access during cleanup
     
     // Registered Godot functions
     std::map<String, Callable> registered_functions;
 
+    // Pre-resolved Lua functions pinned in the registry
+    struct FunctionHandle {
+        int ref = 0;
+        String func_name;
+        String source;  // Chunk name of the file defining the function, empty if not from a file
+    };
+    std::map<int64_t, FunctionHandle> function_handles;
+    int64_t next_function_handle = 1;
+
     // Event bus
     std::map<String, std::vector<String>> event_subscribers;
 
@@ -49,29 +83,94 @@ private:
     std::map<String, Dictionary> loaded_mods;
     std::map<String, bool> mod_enabled_status;
 
+    // Memory owners registered with the allocator; owner id is index + 1
+    struct ModMemoryOwner {
+        String mod_name;
+        CharString source_prefix;  // "@<globalized mod dir>/", matched against chunk names
+    };
+    std::vector<ModMemoryOwner> mod_memory_owners;
+    bool memory_limits_enforced = false;
+
+    // Frame-budgeted garbage collection
+    static const int GC_GENERATIONAL_MINOR_MULTIPLIER = 20;  // Lua's default minor multiplier, percent
+    int64_t gc_frame_budget_usec = 0;  // 0 leaves collection to Lua unless adaptive tuning is on
+    int gc_mode = GC_INCREMENTAL;
+    int gc_pause = 200;  // Heap growth between incremental cycles, percent of the live heap (Lua's default)
+    int gc_step_multiplier = 100;  // Work per incremental step (Lua's default)
+    bool gc_cycle_in_progress = false;
+    int64_t gc_next_cycle_kb = 0;
+    uint64_t gc_last_frame_usec = 0;
+    uint64_t gc_max_frame_usec = 0;
+    uint64_t gc_total_usec = 0;
+    int64_t gc_last_frame_steps = 0;
+    int64_t gc_cycles_completed = 0;
+
+    // Adaptive tuning: measurements are gathered over a window of frames, then the
+    // pause, step multiplier and collector mode are adjusted once per window
+    static const uint64_t GC_TUNING_WINDOW_USEC = 500000;
+    static const uint64_t GC_MIN_ADAPTIVE_BUDGET_USEC = 50;
+    static const int GC_MIN_PAUSE = 110;
+    static const int GC_MAX_PAUSE = 400;
+    static const int GC_MIN_STEP_MULTIPLIER = 25;
+    static const int GC_MAX_STEP_MULTIPLIER = 1600;
+    static const int GC_MODE_SWITCH_COOLDOWN = 4;  // Windows to wait before switching mode again
+    static constexpr double GC_GENERATIONAL_CHURN = 4.0;  // Heap turnovers per window that favor generational mode
+    static constexpr double GC_INCREMENTAL_CHURN = 1.0;  // Turnovers below which generational mode stops paying off
+    struct GCWindow {
+        uint64_t frames = 0;
+        uint64_t frame_usec = 0;
+        uint64_t gc_usec = 0;
+        uint64_t steps = 0;
+        uint64_t overruns = 0;
+        uint64_t allocated_at_start = 0;
+    };
+    bool gc_adaptive = false;
+    float gc_target_frame_fraction = 0.02f;
+    GCWindow gc_window;
+    int gc_windows_since_mode_switch = 0;
+    double gc_allocation_rate_kb_per_sec = 0.0;
+    double gc_frame_fraction = 0.0;
+
     // Lifecycle hooks
     bool lifecycle_initialized = false;
     bool lifecycle_ready = false;
     float update_delta = 0.0f;
 
+    // Memoized require() lookups: "<calling mod>:<module name>" -> resolved path
+    std::map<String, String> module_path_cache;
+
     // Coroutines
     std::map<String, bool> coroutine_active;
 
-    // Object wrappers
+    // Object wrappers created through create_wrapper()
     std::map<Variant, String> object_wrappers;
-    mutable std::map<Variant, Variant> wrapper_objects;
+    std::map<Variant, Variant> wrapper_objects;
 
     // Static Lua callback functions
     static int lua_require_mod(lua_State* L);
     static int lua_class_constructor(lua_State* L);
     static int lua_call_godot_function(lua_State* L);
     static int godot_object_index(lua_State* L);
+    static int lua_godot_method_call(lua_State* L);
+    static int lua_method_info_gc(lua_State* L);
+    static int lua_is_instance_valid(lua_State* L);
     static int lua_godot_object_newindex(lua_State* L);
     static int lua_godot_object_tostring(lua_State* L);
     static int lua_godot_object_gc(lua_State* L);
+    static int lua_container_index(lua_State* L);
+    static int lua_container_newindex(lua_State* L);
+    static int lua_container_len(lua_State* L);
+    static int lua_container_pairs(lua_State* L);
+    static int lua_container_next(lua_State* L);
+    static int lua_container_tostring(lua_State* L);
+    static int lua_container_gc(lua_State* L);
+    static void lua_warning(void* ud, const char* message, int tocont);
     
     // Setup functions
+    void init_lua_state();
     void setup_require_handler();
+    String resolve_module_path(lua_State* L, const String& modname);
+    void invalidate_module_cache(const String& mod_name, const String& mod_dir);
     void setup_game_api();
     void setup_safe_libraries();
     void setup_godot_object_metatable();
@@ -82,19 +181,46 @@ private:
     void expose_class_to_lua(String class_name);
     
     // Data conversion helpers
-    void godot_to_lua(lua_State* L, const Variant& value);
-    Variant lua_to_godot(lua_State* L, int index) const;
+    Variant lua_to_godot(lua_State* L, int index, LuaConversionContext* context) const;
+    Variant lua_table_to_godot(lua_State* L, int index, LuaConversionContext& context) const;
+    Variant lua_to_godot_lazy(lua_State* L, int index) const;
+    Callable lua_function_to_callable(lua_State* L, int index) const;
     static Variant lua_to_variant(lua_State* L, int index);
+    static Variant lua_userdata_to_variant(lua_State* L, int index);
     void push_variant_to_lua(lua_State* L, const Variant& value);
     Array lua_to_variant_array(lua_State* L, int start = 1);
     
     // Object wrapping
-    void push_godot_object_as_userdata(lua_State* L, Object* obj);
+    void push_callable_closure(lua_State* L, const String& name, const Callable& callable, const PackedInt32Array* arg_types);
+    static int lua_registered_function_gc(lua_State* L);
+    static void push_container_proxy(lua_State* L, const Variant& container);
+    static String get_method_cache_key(Object* obj);
+    void push_method_table(lua_State* L, Object* obj);
+    static void resolve_method_info(Object* obj, const char* method_name, BoundMethodInfo* info);
+    void lua_to_typed_variant(lua_State* L, int index, Variant::Type type, Variant& r_value) const;
+    void push_typed_return(lua_State* L, Variant::Type type, const Variant& value);
     
     // Utility functions
     String get_lua_error();
     bool call_lua_function(String func_name, Array args);
 
+    // Function lookup helpers
+    bool push_function_by_name(const String &func_name);
+    Variant call_pushed_function(const String &func_name, const Array &args);
+    Variant pcall_pushed_function(const String &func_name, int arg_count);
+    void invalidate_function_handles(const String& mod_dir);
+
+    // Per-mod memory accounting
+    uint32_t get_mod_memory_owner(const String& mod_name, const String& mod_dir, int64_t memory_limit);
+    uint32_t get_function_memory_owner(int index);
+    uint32_t find_mod_memory_owner(const char* source) const;
+    void emit_memory_budget_events();
+    bool is_gc_frame_driven() const { return gc_frame_budget_usec > 0 || gc_adaptive; }
+    void update_gc_collector_state(bool was_frame_driven);
+    void run_frame_gc(float delta);
+    void step_gc_within_budget(uint64_t budget_usec);
+    void tune_gc(uint64_t frame_usec, uint64_t budget_usec);
+
 protected:
     static void _bind_methods();
 
@@ -139,6 +265,28 @@ public:
      * Unloads the Lua state.
      */
     void unload();
+    /**
+     * Sets whether load_file() and require() keep compiled chunks in user://lua_bytecode_cache.
+     * Entries are keyed by a hash of the source and the Lua version, so edited scripts are
+     * recompiled automatically.
+     * @param enabled Whether to use the bytecode cache.
+     */
+    void set_bytecode_cache_enabled(bool enabled);
+    /**
+     * Gets whether the bytecode cache is used.
+     * @return True if the bytecode cache is enabled.
+     */
+    bool is_bytecode_cache_enabled() const;
+    /**
+     * Deletes every cached compiled chunk.
+     * @return The number of entries removed.
+     */
+    int clear_bytecode_cache();
+    /**
+     * Gets bytecode cache counters for this bridge.
+     * @return enabled, hits, misses, write_failures and cache_dir.
+     */
+    Dictionary get_bytecode_cache_stats() const;
 
     // Global variable management
     /**
@@ -168,6 +316,42 @@ public:
      * @param cb The Callable to register.
      */
     void register_function(String name, Callable cb);
+    /**
+     * Registers a Godot Callable as a Lua function with a declared signature. Exactly
+     * arg_types.size() arguments are passed: missing ones are null, extra ones are dropped,
+     * and each is converted straight to its declared type (TYPE_NIL accepts any value).
+     * @param name The function name.
+     * @param cb The Callable to register.
+     * @param arg_types The Variant.Type of each argument.
+     */
+    void register_function_with_signature(String name, Callable cb, PackedInt32Array arg_types);
+
+    // Pre-resolved function handles
+    /**
+     * Resolves a (possibly dotted) Lua function name once and pins the function in the registry.
+     * Handles to functions defined by a mod's scripts are invalidated when that mod is reloaded.
+     * @param func_name The Lua function name, e.g. "inventory.on_pickup".
+     * @return A handle for call_handle(), or 0 if the function was not found.
+     */
+    int64_t resolve_function(String func_name);
+    /**
+     * Calls a function previously resolved with resolve_function(), skipping all name lookups.
+     * @param handle The function handle.
+     * @param args The arguments to pass.
+     * @return The return value, or Variant() on error or if the handle is invalid.
+     */
+    Variant call_handle(int64_t handle, Array args);
+    /**
+     * Releases a function handle and its registry reference.
+     * @param handle The function handle.
+     */
+    void release_handle(int64_t handle);
+    /**
+     * Checks whether a function handle is still valid.
+     * @param handle The function handle.
+     * @return True if the handle can be called, false otherwise.
+     */
+    bool is_handle_valid(int64_t handle) const;
 
     // Object access
     /**
@@ -248,7 +432,8 @@ public:
 
     // Signal connection
     /**
-     * Connects a Godot signal to a Lua function.
+     * Connects a Godot signal to a Lua function. The function is resolved once and
+     * connected as a Callable, so every signal argument is passed through.
      * @param obj The Godot object emitting the signal.
      * @param signal_name The signal name.
      * @param lua_func_name The Lua function to call.
@@ -324,7 +509,8 @@ public:
 
     // Verbose logging control
     /**
-     * Sets whether verbose logging is enabled.
+     * Sets whether verbose (debug level) logging is enabled. Only this bridge's
+     * diagnostics are affected; other bridges keep their own level.
      * @param enabled Whether to enable verbose logging.
      */
     void set_verbose_logging(bool enabled);
@@ -333,19 +519,215 @@ public:
      * @return True if verbose logging is enabled, false otherwise.
      */
     bool is_verbose_logging() const;
-};
+    /**
+     * Routes Lua print() and bridge diagnostics through a lock-free ring buffer instead of
+     * printing synchronously. The buffer is drained by call_on_update() or flush_logs().
+     * The ring is process-wide: this switches buffering for every bridge.
+     * @param enabled Whether to buffer log output.
+     */
+    void set_log_buffering(bool enabled);
+    /**
+     * Gets whether log output is buffered.
+     * @return True if buffering is enabled, false otherwise.
+     */
+    bool is_log_buffering() const;
+    /**
+     * Sets the ring buffer capacity (rounded up to a power of two). Entries beyond it are dropped.
+     * @param capacity The number of entries.
+     */
+    void set_log_buffer_capacity(int capacity);
+    /**
+     * Gets the ring buffer capacity.
+     * @return The number of entries.
+     */
+    int get_log_buffer_capacity() const;
+    /**
+     * Gets how many log entries were dropped because the ring buffer was full.
+     * @return The dropped entry count.
+     */
+    int64_t get_dropped_log_count() const;
+    /**
+     * Writes out all buffered log entries. Must be called from the main thread.
+     * @return The number of entries delivered.
+     */
+    int flush_logs();
+    /**
+     * Enables log output per category (bitmask of LOG_BRIDGE, LOG_CONVERSION, LOG_GC, LOG_MODS, LOG_RESOURCES).
+     * Disabled categories cost a single branch per log site. Only this bridge's
+     * diagnostics are affected.
+     * @param categories The enabled categories.
+     */
+    void set_log_categories(int categories);
+    /**
+     * Gets the enabled log categories.
+     * @return The category bitmask.
+     */
+    int get_log_categories() const;
 
-// Helper relay for forwarding Godot signals to Lua
-class LuaSignalRelay : public RefCounted {
-    GDCLASS(LuaSignalRelay, RefCounted)
-    LuaBridge* bridge = nullptr;
-    String lua_func_name;
-public:
-    void setup(LuaBridge* b, String func) { bridge = b; lua_func_name = func; }
-    void _on_signal(Variant arg) {
-        if (bridge) bridge->call_function(lua_func_name, Array::make(arg));
-    }
-    static void _bind_methods() {}
+    // Native binding support (C++ only, used by lua_bind_native.h)
+    /**
+     * Gets the raw Lua state, or null once the bridge has been unloaded.
+     */
+    lua_State* get_lua_state() const { return L; }
+    /**
+     * Pushes a Godot value onto the Lua stack using the bridge's conversion rules.
+     */
+    void godot_to_lua(lua_State* L, const Variant& value);
+    /**
+     * Converts the Lua value at the given stack index to a Godot value.
+     */
+    Variant lua_to_godot(lua_State* L, int index) const;
+    /**
+     * Pushes a Godot object as its (cached) GodotObject userdata.
+     */
+    void push_godot_object_as_userdata(lua_State* L, Object* obj);
+    /**
+     * Gets the live object behind a GodotObject userdata, or null if it is not one or was freed.
+     */
+    static Object* get_wrapped_object(lua_State* L, int index);
+    /**
+     * Gets the live object behind a GodotObject userdata, raising a Lua error if it is not one or was freed.
+     */
+    static Object* check_wrapped_object(lua_State* L, int index);
+
+    // Conversion limits
+    /**
+     * Sets how deeply nested Lua tables may be when converted to Godot values.
+     * Deeper tables fail the conversion with an error instead of exhausting the stack.
+     * @param depth The maximum nesting depth.
+     */
+    void set_conversion_max_depth(int depth);
+    /**
+     * Gets the maximum table nesting depth for conversions.
+     * @return The maximum nesting depth.
+     */
+    int get_conversion_max_depth() const;
+    /**
+     * Sets how many table entries a single Lua to Godot conversion may visit.
+     * @param max_elements The entry budget, or 0 for no limit.
+     */
+    void set_conversion_max_elements(int64_t max_elements);
+    /**
+     * Gets the table entry budget for a single conversion.
+     * @return The entry budget, or 0 for no limit.
+     */
+    int64_t get_conversion_max_elements() const;
+    /**
+     * Sets whether tables returned by get_global(), call_function() and call_handle() come back
+     * as LuaTable proxies that convert fields on access, instead of deep-copied Dictionaries/Arrays.
+     * @param enabled Whether to return table proxies.
+     */
+    void set_table_proxies_enabled(bool enabled);
+    /**
+     * Gets whether tables are returned as LuaTable proxies.
+     * @return True if table proxies are enabled.
+     */
+    bool is_table_proxies_enabled() const;
+    /**
+     * Sets whether Dictionaries and Arrays enter Lua (set_global(), call_function() arguments,
+     * emit_event() data, ...) as proxy userdata over the shared Godot container instead of
+     * being copied into a new table. Proxies support indexing, assignment, # and pairs();
+     * Arrays are 1-based. Writes from Lua go straight into the Godot container.
+     * @param enabled Whether to pass containers as proxies.
+     */
+    void set_container_proxies_enabled(bool enabled);
+    /**
+     * Gets whether Dictionaries and Arrays are passed into Lua as proxies.
+     * @return True if container proxies are enabled.
+     */
+    bool is_container_proxies_enabled() const;
+
+    // Memory
+    /**
+     * Gets counters of the pooled allocator backing the Lua state.
+     * @return bytes_in_use, peak_bytes, pool_bytes_reserved, allocations, frees, large_allocations
+     *         and size_classes (an Array of { size, allocations, blocks_in_use }), or an empty
+     *         Dictionary once the state has been unloaded. mods maps each mod name to
+     *         { bytes_in_use, memory_limit }.
+     */
+    Dictionary get_memory_stats() const;
+    /**
+     * Gets the Lua memory currently charged to a mod. Allocations are charged to the mod whose
+     * code is running: its entry script while loading, and functions defined in its directory
+     * when called through call_function(), call_handle(), lifecycle hooks or signals.
+     * @param mod_name The mod name.
+     * @return The bytes in use, or 0 if the mod is unknown.
+     */
+    int64_t get_mod_memory_usage(String mod_name) const;
+    /**
+     * Sets what happens when a mod exceeds the memory_limit from its mod.json. When enforced,
+     * the allocation fails and Lua raises "not enough memory" in the mod's code; either way
+     * mod_over_budget(mod_name, bytes_in_use, memory_limit) is emitted once the call returns.
+     * Off by default: a failed allocation can unwind through bridge code that holds Godot
+     * values, which then leak, so enforcing is meant for hosts that would rather leak than
+     * let a mod keep growing.
+     * @param enforced Whether to fail allocations over the limit.
+     */
+    void set_memory_limits_enforced(bool enforced);
+    /**
+     * Gets whether mod memory limits fail allocations.
+     * @return True if limits are enforced, false if they only emit mod_over_budget.
+     */
+    bool is_memory_limits_enforced() const;
+
+    // Garbage collection
+    /**
+     * Moves garbage collection into call_on_update(). Lua's automatic collector is stopped and
+     * each frame steps the collector until the budget is used up or the cycle completes; a new
+     * cycle starts once the heap has grown by Lua's default pause (or minor multiplier in
+     * generational mode). A single generational step is a whole minor collection and may exceed
+     * the budget. The destructor and unload() still run a full collection.
+     * @param usec The per-frame budget in microseconds, or 0 to hand collection back to Lua.
+     */
+    void set_gc_frame_budget(int64_t usec);
+    /**
+     * Gets the per-frame garbage collection budget.
+     * @return The budget in microseconds, or 0 if Lua collects automatically.
+     */
+    int64_t get_gc_frame_budget() const;
+    /**
+     * Sets the collector mode. Switching to GC_GENERATIONAL runs a full collection.
+     * @param mode GC_INCREMENTAL or GC_GENERATIONAL.
+     */
+    void set_gc_mode(int mode);
+    /**
+     * Gets the collector mode.
+     * @return GC_INCREMENTAL or GC_GENERATIONAL.
+     */
+    int get_gc_mode() const;
+    /**
+     * Retunes the collector from the measured allocation rate and GC time, to hold collection
+     * under the target fraction of frame time. Every half second of frames the incremental pause
+     * and step multiplier are adjusted, and the bridge switches to generational mode when the heap
+     * is turned over several times per window (most garbage dies young) and back when minor
+     * collections get expensive. Collection runs from call_on_update(); without a frame budget
+     * each frame gets the target fraction of its delta. Enabling this lets it change get_gc_mode().
+     * @param enabled Whether to tune the collector automatically.
+     */
+    void set_gc_adaptive(bool enabled);
+    /**
+     * Gets whether the collector is tuned automatically.
+     * @return True if adaptive tuning is enabled.
+     */
+    bool is_gc_adaptive() const;
+    /**
+     * Sets the share of frame time adaptive tuning aims to keep garbage collection under.
+     * @param fraction The target fraction, e.g. 0.02 for 2%.
+     */
+    void set_gc_target_frame_fraction(float fraction);
+    /**
+     * Gets the share of frame time adaptive tuning aims for.
+     * @return The target fraction.
+     */
+    float get_gc_target_frame_fraction() const;
+    /**
+     * Gets the measured cost of frame-budgeted collection.
+     * @return frame_budget_usec, last_frame_usec, max_frame_usec, total_usec, last_frame_steps,
+     *         cycles_completed, memory_kb (the Lua heap size), mode, adaptive, pause,
+     *         step_multiplier, allocation_rate_kb_per_sec and frame_fraction (GC share of frame
+     *         time over the last tuning window).
+     */
+    Dictionary get_gc_stats() const;
 };
 
 }
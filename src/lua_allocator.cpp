@@ -0,0 +1,296 @@
+#include "lua_allocator.h"
+
+#include <godot_cpp/variant/array.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace godot;
+
+// Block sizes of the pooled classes. Steps of 16 up to 128 cover strings, table
+// nodes and closures; the coarser steps above keep the class count small.
+static const size_t SIZE_CLASS_SIZES[LuaAllocator::SIZE_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256
+};
+
+// Size class for each 16-byte step, indexed by (size + 15) / 16
+static const int8_t SIZE_CLASS_LOOKUP[LuaAllocator::MAX_SMALL_SIZE / LuaAllocator::SIZE_CLASS_GRANULARITY + 1] = {
+	0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11
+};
+
+LuaAllocator::LuaAllocator() {
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		classes[i].size = SIZE_CLASS_SIZES[i];
+	}
+}
+
+LuaAllocator::~LuaAllocator() {
+	// Pooled blocks are never returned individually; the chunks go back in one pass
+	for (void *chunk : chunks) {
+		std::free(chunk);
+	}
+	chunks.clear();
+}
+
+int LuaAllocator::get_size_class(size_t p_size) {
+	if (p_size == 0 || p_size > MAX_SMALL_SIZE) {
+		return -1;
+	}
+	return SIZE_CLASS_LOOKUP[(p_size + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY];
+}
+
+bool LuaAllocator::refill(SizeClass &p_class) {
+	char *chunk = static_cast<char *>(std::malloc(CHUNK_SIZE));
+	if (!chunk) {
+		return false;
+	}
+	chunks.push_back(chunk);
+	pool_bytes_reserved += CHUNK_SIZE;
+
+	// Thread the chunk into the free list back to front so blocks are handed out in address order
+	size_t count = CHUNK_SIZE / p_class.size;
+	for (size_t i = count; i > 0; i--) {
+		FreeBlock *block = reinterpret_cast<FreeBlock *>(chunk + (i - 1) * p_class.size);
+		block->next = p_class.free_list;
+		p_class.free_list = block;
+	}
+	return true;
+}
+
+void *LuaAllocator::allocate_block(size_t p_size) {
+	int index = get_size_class(p_size);
+	if (index < 0) {
+		void *block = std::malloc(p_size);
+		if (block) {
+			large_allocations++;
+		}
+		return block;
+	}
+	SizeClass &size_class = classes[index];
+	if (!size_class.free_list && !refill(size_class)) {
+		return nullptr;
+	}
+	FreeBlock *head = size_class.free_list;
+	size_class.free_list = head->next;
+	size_class.allocations++;
+	size_class.blocks_in_use++;
+	return head;
+}
+
+void LuaAllocator::free_block(void *p_block, size_t p_size) {
+	int index = get_size_class(p_size);
+	if (index < 0) {
+		std::free(p_block);
+		return;
+	}
+	SizeClass &size_class = classes[index];
+	FreeBlock *block = static_cast<FreeBlock *>(p_block);
+	block->next = size_class.free_list;
+	size_class.free_list = block;
+	size_class.blocks_in_use--;
+}
+
+void *LuaAllocator::reallocate_block(void *p_block, size_t p_old_size, size_t p_new_size) {
+	int old_index = get_size_class(p_old_size);
+	int new_index = get_size_class(p_new_size);
+
+	if (old_index >= 0 && old_index == new_index) {
+		// Still fits the same block
+		return p_block;
+	}
+	if (old_index < 0 && new_index < 0) {
+		// Large to large: let the system allocator grow in place when it can
+		return std::realloc(p_block, p_new_size);
+	}
+
+	// Crossing a class boundary: move the contents. On failure the old block stays valid, as Lua expects.
+	void *block = allocate_block(p_new_size);
+	if (!block) {
+		return nullptr;
+	}
+	std::memcpy(block, p_block, p_old_size < p_new_size ? p_old_size : p_new_size);
+	free_block(p_block, p_old_size);
+	return block;
+}
+
+uint32_t LuaAllocator::create_owner(size_t p_limit) {
+	Owner owner;
+	owner.limit = p_limit;
+	owners.push_back(owner);
+	return (uint32_t)owners.size();
+}
+
+void LuaAllocator::set_owner_limit(uint32_t p_owner, size_t p_limit) {
+	if (p_owner == NO_OWNER || p_owner > owners.size()) {
+		return;
+	}
+	Owner &owner = owners[p_owner - 1];
+	owner.limit = p_limit;
+	owner.over_budget = p_limit != 0 && owner.bytes_in_use > p_limit;
+}
+
+size_t LuaAllocator::get_owner_limit(uint32_t p_owner) const {
+	if (p_owner == NO_OWNER || p_owner > owners.size()) {
+		return 0;
+	}
+	return owners[p_owner - 1].limit;
+}
+
+size_t LuaAllocator::get_owner_bytes(uint32_t p_owner) const {
+	if (p_owner == NO_OWNER || p_owner > owners.size()) {
+		return 0;
+	}
+	return owners[p_owner - 1].bytes_in_use;
+}
+
+bool LuaAllocator::take_budget_event(uint32_t &r_owner) {
+	if (budget_events.empty()) {
+		return false;
+	}
+	r_owner = budget_events.front();
+	budget_events.erase(budget_events.begin());
+	return true;
+}
+
+bool LuaAllocator::charge(uint32_t p_owner, size_t p_size) {
+	if (p_owner == NO_OWNER || p_owner > owners.size()) {
+		return true;
+	}
+	Owner &owner = owners[p_owner - 1];
+	if (owner.limit != 0 && owner.bytes_in_use + p_size > owner.limit) {
+		if (!owner.over_budget) {
+			owner.over_budget = true;
+			// The emergency collection Lua runs on a failed allocation can re-arm the owner; report it once per drain
+			if (std::find(budget_events.begin(), budget_events.end(), p_owner) == budget_events.end()) {
+				budget_events.push_back(p_owner);
+			}
+		}
+		if (limits_enforced) {
+			return false;
+		}
+	}
+	owner.bytes_in_use += p_size;
+	return true;
+}
+
+void LuaAllocator::credit(uint32_t p_owner, size_t p_size) {
+	if (p_owner == NO_OWNER || p_owner > owners.size()) {
+		return;
+	}
+	Owner &owner = owners[p_owner - 1];
+	owner.bytes_in_use -= p_size;
+	// Re-arm the event only once the owner is clearly back under budget, so a mod
+	// hovering at its limit does not report on every failed allocation
+	if (owner.over_budget && owner.bytes_in_use <= owner.limit - owner.limit / 10) {
+		owner.over_budget = false;
+	}
+}
+
+void *LuaAllocator::allocate(size_t p_size) {
+	uint32_t owner = current_owner;
+	if (!charge(owner, p_size)) {
+		return nullptr;
+	}
+	BlockHeader *header = static_cast<BlockHeader *>(allocate_block(p_size + sizeof(BlockHeader)));
+	if (!header) {
+		credit(owner, p_size);
+		return nullptr;
+	}
+	header->owner = owner;
+
+	allocations++;
+	bytes_allocated_total += p_size;
+	bytes_in_use += p_size;
+	if (bytes_in_use > peak_bytes) {
+		peak_bytes = bytes_in_use;
+	}
+	return header + 1;
+}
+
+void LuaAllocator::deallocate(void *p_ptr, size_t p_size) {
+	BlockHeader *header = static_cast<BlockHeader *>(p_ptr) - 1;
+	credit(header->owner, p_size);
+	free_block(header, p_size + sizeof(BlockHeader));
+	frees++;
+	bytes_in_use -= p_size;
+}
+
+void *LuaAllocator::reallocate(void *p_ptr, size_t p_old_size, size_t p_new_size) {
+	BlockHeader *header = static_cast<BlockHeader *>(p_ptr) - 1;
+	uint32_t old_owner = header->owner;
+	// A growing block is charged to the code growing it. Shrinks keep their owner and
+	// never fail, since the collector shrinks tables and strings while it runs.
+	uint32_t new_owner = p_new_size > p_old_size ? current_owner : old_owner;
+
+	if (new_owner == old_owner) {
+		if (p_new_size > p_old_size && !charge(new_owner, p_new_size - p_old_size)) {
+			return nullptr;
+		}
+	} else if (!charge(new_owner, p_new_size)) {
+		return nullptr;
+	}
+
+	BlockHeader *block = static_cast<BlockHeader *>(reallocate_block(header, p_old_size + sizeof(BlockHeader), p_new_size + sizeof(BlockHeader)));
+	if (!block) {
+		if (new_owner != old_owner) {
+			credit(new_owner, p_new_size);
+		} else if (p_new_size > p_old_size) {
+			credit(new_owner, p_new_size - p_old_size);
+		}
+		return nullptr;
+	}
+
+	if (new_owner != old_owner) {
+		credit(old_owner, p_old_size);
+		block->owner = new_owner;
+	} else if (p_new_size < p_old_size) {
+		credit(old_owner, p_old_size - p_new_size);
+	}
+
+	if (p_new_size > p_old_size) {
+		bytes_allocated_total += p_new_size - p_old_size;
+	}
+	bytes_in_use = bytes_in_use - p_old_size + p_new_size;
+	if (bytes_in_use > peak_bytes) {
+		peak_bytes = bytes_in_use;
+	}
+	return block + 1;
+}
+
+void *LuaAllocator::lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+	LuaAllocator *allocator = static_cast<LuaAllocator *>(ud);
+	if (nsize == 0) {
+		if (ptr) {
+			allocator->deallocate(ptr, osize);
+		}
+		return nullptr;
+	}
+	if (!ptr) {
+		// osize is the type tag of the new object here, not a size
+		return allocator->allocate(nsize);
+	}
+	return allocator->reallocate(ptr, osize, nsize);
+}
+
+Dictionary LuaAllocator::get_stats() const {
+	Dictionary stats;
+	stats["bytes_in_use"] = (int64_t)bytes_in_use;
+	stats["peak_bytes"] = (int64_t)peak_bytes;
+	stats["pool_bytes_reserved"] = (int64_t)pool_bytes_reserved;
+	stats["allocations"] = (int64_t)allocations;
+	stats["frees"] = (int64_t)frees;
+	stats["large_allocations"] = (int64_t)large_allocations;
+	stats["header_bytes"] = (int64_t)((allocations - frees) * sizeof(BlockHeader));
+
+	Array size_classes;
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		Dictionary entry;
+		entry["size"] = (int64_t)classes[i].size;
+		entry["allocations"] = (int64_t)classes[i].allocations;
+		entry["blocks_in_use"] = (int64_t)classes[i].blocks_in_use;
+		size_classes.append(entry);
+	}
+	stats["size_classes"] = size_classes;
+	return stats;
+}
@@ -0,0 +1,146 @@
+#ifndef LUA_ALLOCATOR_H
+#define LUA_ALLOCATOR_H
+
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+// lua_Alloc backing one lua_State. Small blocks (strings, table nodes, closures,
+// userdata headers) come from per-size-class free lists carved out of large
+// chunks, so the interpreter's churn of tiny allocations never reaches the
+// system allocator. Larger blocks fall through to realloc/free.
+//
+// Lua always passes the old block size on free and realloc, so the size class is
+// recomputed from osize. Each block starts with an 8-byte header naming the owner
+// (mod) it is charged to, so memory freed later by the collector is credited back
+// to the right owner. A lua_State is only ever used from one thread at a time, so
+// the allocator does no locking.
+class LuaAllocator {
+public:
+    static constexpr size_t SIZE_CLASS_GRANULARITY = 16;
+    static constexpr size_t MAX_SMALL_SIZE = 256;
+    static constexpr int SIZE_CLASS_COUNT = 12;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    // Owner 0 is the bridge itself and is never limited
+    static constexpr uint32_t NO_OWNER = 0;
+
+    LuaAllocator();
+    ~LuaAllocator();
+
+    LuaAllocator(const LuaAllocator &) = delete;
+    LuaAllocator &operator=(const LuaAllocator &) = delete;
+
+    /**
+     * The lua_Alloc entry point; ud is the LuaAllocator.
+     */
+    static void *lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+
+    /**
+     * Gets the allocator counters.
+     * @return bytes_in_use, peak_bytes, pool_bytes_reserved, allocations, frees,
+     *         large_allocations, header_bytes and a size_classes array of { size, allocations, blocks_in_use }.
+     */
+    Dictionary get_stats() const;
+
+    size_t get_bytes_in_use() const { return bytes_in_use; }
+    // Bytes handed out since creation, growth by realloc included; the allocation rate is its derivative
+    uint64_t get_bytes_allocated_total() const { return bytes_allocated_total; }
+
+    // Owners
+    /**
+     * Adds an owner that allocations can be charged to.
+     * @param p_limit The most bytes the owner may hold, or 0 for no limit.
+     * @return The owner id.
+     */
+    uint32_t create_owner(size_t p_limit);
+    void set_owner_limit(uint32_t p_owner, size_t p_limit);
+    size_t get_owner_limit(uint32_t p_owner) const;
+    size_t get_owner_bytes(uint32_t p_owner) const;
+
+    /**
+     * Sets the owner charged for new allocations and for blocks grown by realloc.
+     */
+    void set_current_owner(uint32_t p_owner) { current_owner = p_owner; }
+    uint32_t get_current_owner() const { return current_owner; }
+
+    /**
+     * When enforced, an allocation that would take an owner over its limit fails
+     * (Lua raises "not enough memory" in the owner's code). Otherwise, the default,
+     * it succeeds and only the over-budget event is recorded.
+     */
+    void set_limits_enforced(bool p_enforced) { limits_enforced = p_enforced; }
+    bool are_limits_enforced() const { return limits_enforced; }
+
+    /**
+     * Pops the next owner that went over its limit. Events are queued instead of
+     * reported from inside the allocator, where no Lua or Godot code may run.
+     * An owner is reported again only after dropping back under its limit.
+     * @param r_owner Receives the owner id.
+     * @return False if no event is pending.
+     */
+    bool take_budget_event(uint32_t &r_owner);
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    // Keeps the payload aligned to 8 bytes, as Lua requires (LUAI_MAXALIGN)
+    struct BlockHeader {
+        uint32_t owner;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(BlockHeader) == 8, "BlockHeader must stay 8 bytes");
+
+    struct SizeClass {
+        size_t size = 0;
+        FreeBlock *free_list = nullptr;
+        uint64_t allocations = 0;
+        uint64_t blocks_in_use = 0;
+    };
+
+    struct Owner {
+        size_t bytes_in_use = 0;
+        size_t limit = 0;
+        bool over_budget = false;
+    };
+
+    SizeClass classes[SIZE_CLASS_COUNT];
+    std::vector<void *> chunks;
+    std::vector<Owner> owners;
+    std::vector<uint32_t> budget_events;
+    uint32_t current_owner = NO_OWNER;
+    bool limits_enforced = false;
+
+    size_t bytes_in_use = 0;
+    size_t peak_bytes = 0;
+    uint64_t bytes_allocated_total = 0;
+    size_t pool_bytes_reserved = 0;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t large_allocations = 0;
+
+    static int get_size_class(size_t p_size);
+
+    // Pool operations on whole blocks, header included
+    void *allocate_block(size_t p_size);
+    void free_block(void *p_block, size_t p_size);
+    void *reallocate_block(void *p_block, size_t p_old_size, size_t p_new_size);
+    bool refill(SizeClass &p_class);
+
+    bool charge(uint32_t p_owner, size_t p_size);
+    void credit(uint32_t p_owner, size_t p_size);
+
+    void *allocate(size_t p_size);
+    void deallocate(void *p_ptr, size_t p_size);
+    void *reallocate(void *p_ptr, size_t p_old_size, size_t p_new_size);
+};
+
+} // namespace godot
+
+#endif // LUA_ALLOCATOR_H
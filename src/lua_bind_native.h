@@ -0,0 +1,257 @@
+#ifndef LUA_BIND_NATIVE_H
+#define LUA_BIND_NATIVE_H
+
+#include "bridge.h"
+#include "lua_value_types.h"
+
+#include <godot_cpp/variant/basis.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/transform2d.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <type_traits>
+#include <utility>
+
+// Lua includes
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+// Header-only binding of plain C++ functions as Lua globals. The Lua C thunk is
+// generated at compile time from the function signature: arguments are read
+// straight off the Lua stack and the result is pushed straight back, with no
+// Variant, Array or Callable in between.
+//
+//     static double damage(double base, int64_t level, const Vector2 &dir) { ... }
+//     bind_native<double(double, int64_t, const Vector2 &)>(bridge, "damage", &damage);
+//
+// Supported argument and return types: bool, integers, float, double, String,
+// StringName, const char * (argument only, valid for the duration of the call),
+// Vector2, Vector3, Color, Rect2, Transform2D, Basis, Transform3D, pointers to
+// Object subclasses (nil <-> nullptr) and Variant (generic conversion).
+
+namespace godot {
+
+namespace lua_native {
+
+// Argument readers. check() raises a Lua error when the value does not fit and is
+// run for every argument before any get(), so lua_error's longjmp never skips the
+// destructor of an already converted argument.
+template <typename T, typename Enable = void>
+struct LuaArg;
+
+template <typename T>
+struct LuaArg<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static void check(lua_State *L, int index) { luaL_checkinteger(L, index); }
+    static T get(lua_State *L, int index, LuaBridge *) { return (T)lua_tointeger(L, index); }
+};
+
+template <typename T>
+struct LuaArg<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static void check(lua_State *L, int index) { luaL_checknumber(L, index); }
+    static T get(lua_State *L, int index, LuaBridge *) { return (T)lua_tonumber(L, index); }
+};
+
+template <>
+struct LuaArg<bool> {
+    // Lua truthiness: a missing argument is false
+    static void check(lua_State *, int) {}
+    static bool get(lua_State *L, int index, LuaBridge *) { return lua_toboolean(L, index); }
+};
+
+template <>
+struct LuaArg<const char *> {
+    static void check(lua_State *L, int index) { luaL_checkstring(L, index); }
+    static const char *get(lua_State *L, int index, LuaBridge *) { return lua_tostring(L, index); }
+};
+
+template <>
+struct LuaArg<String> {
+    static void check(lua_State *L, int index) { luaL_checkstring(L, index); }
+    static String get(lua_State *L, int index, LuaBridge *) {
+        size_t len = 0;
+        const char *str = lua_tolstring(L, index, &len);
+        return String::utf8(str, (int)len);
+    }
+};
+
+template <>
+struct LuaArg<StringName> {
+    static void check(lua_State *L, int index) { luaL_checkstring(L, index); }
+    static StringName get(lua_State *L, int index, LuaBridge *bridge) { return LuaArg<String>::get(L, index, bridge); }
+};
+
+template <>
+struct LuaArg<Variant> {
+    static void check(lua_State *, int) {}
+    static Variant get(lua_State *L, int index, LuaBridge *bridge) { return bridge->lua_to_godot(L, index); }
+};
+
+// Value types are read in place from their userdata
+template <typename T>
+struct LuaValueArg {
+    static void check(lua_State *L, int index, const char *name) {
+        if (!lua_test_value<T>(L, index)) {
+            luaL_typeerror(L, index, name);
+        }
+    }
+    static T get(lua_State *L, int index, LuaBridge *) { return *lua_test_value<T>(L, index); }
+};
+
+template <>
+struct LuaArg<Vector2> : LuaValueArg<Vector2> {
+    static void check(lua_State *L, int index) { LuaValueArg::check(L, index, "Vector2"); }
+};
+
+template <>
+struct LuaArg<Vector3> : LuaValueArg<Vector3> {
+    static void check(lua_State *L, int index) { LuaValueArg::check(L, index, "Vector3"); }
+};
+
+template <>
+struct LuaArg<Color> : LuaValueArg<Color> {
+    static void check(lua_State *L, int index) { LuaValueArg::check(L, index, "Color"); }
+};
+
+template <>
+struct LuaArg<Rect2> : LuaValueArg<Rect2> {
+    static void check(lua_State *L, int index) { LuaValueArg::check(L, index, "Rect2"); }
+};
+
+template <>
+struct LuaArg<Transform2D> : LuaValueArg<Transform2D> {
+    static void check(lua_State *L, int index) { LuaValueArg::check(L, index, "Transform2D"); }
+};
+
+template <>
+struct LuaArg<Basis> : LuaValueArg<Basis> {
+    static void check(lua_State *L, int index) { LuaValueArg::check(L, index, "Basis"); }
+};
+
+template <>
+struct LuaArg<Transform3D> : LuaValueArg<Transform3D> {
+    static void check(lua_State *L, int index) { LuaValueArg::check(L, index, "Transform3D"); }
+};
+
+template <typename T>
+struct LuaArg<T *, std::enable_if_t<std::is_base_of_v<Object, T>>> {
+    static void check(lua_State *L, int index) {
+        if (lua_isnoneornil(L, index)) {
+            return;
+        }
+        if (!Object::cast_to<T>(LuaBridge::check_wrapped_object(L, index))) {
+            luaL_argerror(L, index, "object is not of the expected class");
+        }
+    }
+    static T *get(lua_State *L, int index, LuaBridge *) {
+        return lua_isnoneornil(L, index) ? nullptr : Object::cast_to<T>(LuaBridge::get_wrapped_object(L, index));
+    }
+};
+
+// Result writers
+template <typename T, typename Enable = void>
+struct LuaRet;
+
+template <typename T>
+struct LuaRet<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static void push(lua_State *L, LuaBridge *, T value) { lua_pushinteger(L, (lua_Integer)value); }
+};
+
+template <typename T>
+struct LuaRet<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static void push(lua_State *L, LuaBridge *, T value) { lua_pushnumber(L, (lua_Number)value); }
+};
+
+template <>
+struct LuaRet<bool> {
+    static void push(lua_State *L, LuaBridge *, bool value) { lua_pushboolean(L, value); }
+};
+
+template <>
+struct LuaRet<String> {
+    static void push(lua_State *L, LuaBridge *, const String &value) {
+        CharString utf8 = value.utf8();
+        lua_pushlstring(L, utf8.get_data(), utf8.length());
+    }
+};
+
+template <>
+struct LuaRet<StringName> {
+    static void push(lua_State *L, LuaBridge *bridge, const StringName &value) { LuaRet<String>::push(L, bridge, value); }
+};
+
+template <>
+struct LuaRet<Variant> {
+    static void push(lua_State *L, LuaBridge *bridge, const Variant &value) { bridge->godot_to_lua(L, value); }
+};
+
+template <typename T>
+struct LuaRet<T, std::enable_if_t<std::is_same_v<T, Vector2> || std::is_same_v<T, Vector3> ||
+        std::is_same_v<T, Color> || std::is_same_v<T, Rect2> || std::is_same_v<T, Transform2D> ||
+        std::is_same_v<T, Basis> || std::is_same_v<T, Transform3D>>> {
+    static void push(lua_State *L, LuaBridge *, const T &value) { lua_push_value(L, value); }
+};
+
+template <typename T>
+struct LuaRet<T *, std::enable_if_t<std::is_base_of_v<Object, T>>> {
+    static void push(lua_State *L, LuaBridge *bridge, T *value) { bridge->push_godot_object_as_userdata(L, value); }
+};
+
+template <typename Signature>
+struct NativeThunk;
+
+template <typename R, typename... Args>
+struct NativeThunk<R(Args...)> {
+    using Function = R (*)(Args...);
+
+    template <size_t... I>
+    static int invoke(lua_State *L, LuaBridge *bridge, Function fn, std::index_sequence<I...>) {
+        (LuaArg<std::decay_t<Args>>::check(L, (int)I + 1), ...);
+        if constexpr (std::is_void_v<R>) {
+            fn(LuaArg<std::decay_t<Args>>::get(L, (int)I + 1, bridge)...);
+            return 0;
+        } else {
+            LuaRet<std::decay_t<R>>::push(L, bridge, fn(LuaArg<std::decay_t<Args>>::get(L, (int)I + 1, bridge)...));
+            return 1;
+        }
+    }
+
+    // Upvalues: the bridge (light userdata) and the function pointer (full userdata,
+    // since function pointers cannot portably be stored in a void *)
+    static int thunk(lua_State *L) {
+        LuaBridge *bridge = static_cast<LuaBridge *>(lua_touserdata(L, lua_upvalueindex(1)));
+        Function fn = *static_cast<Function *>(lua_touserdata(L, lua_upvalueindex(2)));
+        return invoke(L, bridge, fn, std::index_sequence_for<Args...>{});
+    }
+};
+
+} // namespace lua_native
+
+/**
+ * Binds a C++ function (or captureless lambda) as a global Lua function.
+ * @param bridge The bridge whose Lua state receives the function.
+ * @param name The global name.
+ * @param fn The function; Signature is given explicitly, e.g. bind_native<int64_t(int64_t, int64_t)>.
+ * @return False if the bridge has no Lua state.
+ */
+template <typename Signature>
+bool bind_native(LuaBridge *bridge, const String &name, Signature *fn) {
+    lua_State *L = bridge ? bridge->get_lua_state() : nullptr;
+    if (!L || !fn) {
+        return false;
+    }
+    lua_pushlightuserdata(L, bridge);
+    Signature **slot = static_cast<Signature **>(lua_newuserdatauv(L, sizeof(Signature *), 0));
+    *slot = fn;
+    lua_pushcclosure(L, &lua_native::NativeThunk<Signature>::thunk, 2);
+    lua_setglobal(L, name.utf8().get_data());
+    return true;
+}
+
+} // namespace godot
+
+#endif // LUA_BIND_NATIVE_H
@@ -0,0 +1,98 @@
+#include "lua_callable.h"
+#include "bridge.h"
+
+#include <godot_cpp/templates/hashfuncs.hpp>
+
+// Lua includes
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+using namespace godot;
+
+LuaCallable::LuaCallable(ObjectID p_bridge_id, int p_ref, const void *p_function_ptr, const String &p_text) :
+		bridge_id(p_bridge_id),
+		ref(p_ref),
+		function_ptr(p_function_ptr),
+		text(p_text) {
+}
+
+LuaCallable::~LuaCallable() {
+	LuaBridge *bridge = Object::cast_to<LuaBridge>(ObjectDB::get_instance(bridge_id));
+	if (bridge && bridge->L) {
+		luaL_unref(bridge->L, LUA_REGISTRYINDEX, ref);
+	}
+}
+
+const LuaCallable *LuaCallable::from_callable(const Callable &p_callable) {
+	// Every LuaCallable shares the same comparator, which identifies the type without RTTI
+	CallableCustom *custom = p_callable.get_custom();
+	if (custom && custom->get_compare_equal_func() == &LuaCallable::compare_equal) {
+		return static_cast<const LuaCallable *>(custom);
+	}
+	return nullptr;
+}
+
+bool LuaCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+	const LuaCallable *a = static_cast<const LuaCallable *>(p_a);
+	const LuaCallable *b = static_cast<const LuaCallable *>(p_b);
+	return a->bridge_id == b->bridge_id && a->function_ptr == b->function_ptr;
+}
+
+bool LuaCallable::compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+	const LuaCallable *a = static_cast<const LuaCallable *>(p_a);
+	const LuaCallable *b = static_cast<const LuaCallable *>(p_b);
+	if (a->bridge_id != b->bridge_id) {
+		return (uint64_t)a->bridge_id < (uint64_t)b->bridge_id;
+	}
+	return a->function_ptr < b->function_ptr;
+}
+
+uint32_t LuaCallable::hash() const {
+	// The registry reference keeps the function alive, so its address is stable
+	return hash_murmur3_one_64((uint64_t)(uintptr_t)function_ptr, hash_murmur3_one_64((uint64_t)bridge_id));
+}
+
+String LuaCallable::get_as_text() const {
+	return text;
+}
+
+CallableCustom::CompareEqualFunc LuaCallable::get_compare_equal_func() const {
+	return &LuaCallable::compare_equal;
+}
+
+CallableCustom::CompareLessFunc LuaCallable::get_compare_less_func() const {
+	return &LuaCallable::compare_less;
+}
+
+bool LuaCallable::is_valid() const {
+	LuaBridge *bridge = Object::cast_to<LuaBridge>(ObjectDB::get_instance(bridge_id));
+	return bridge && bridge->L && !bridge->is_cleaning_up;
+}
+
+ObjectID LuaCallable::get_object() const {
+	return bridge_id;
+}
+
+void LuaCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, GDExtensionCallError &r_call_error) const {
+	LuaBridge *bridge = Object::cast_to<LuaBridge>(ObjectDB::get_instance(bridge_id));
+	if (!bridge || !bridge->L || bridge->is_cleaning_up) {
+		r_call_error.error = GDEXTENSION_CALL_ERROR_INSTANCE_IS_NULL;
+		return;
+	}
+	lua_State *L = bridge->L;
+	if (!lua_checkstack(L, p_argcount + 1)) {
+		r_call_error.error = GDEXTENSION_CALL_ERROR_TOO_MANY_ARGUMENTS;
+		r_call_error.expected = 0;
+		return;
+	}
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+	for (int i = 0; i < p_argcount; i++) {
+		bridge->godot_to_lua(L, *p_arguments[i]);
+	}
+	// Lua errors are reported by the bridge; the call itself still succeeded
+	r_return_value = bridge->pcall_pushed_function(text, p_argcount);
+	r_call_error.error = GDEXTENSION_CALL_OK;
+}
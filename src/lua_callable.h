@@ -0,0 +1,51 @@
+#ifndef LUA_CALLABLE_H
+#define LUA_CALLABLE_H
+
+#include <godot_cpp/core/object_id.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/callable_custom.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+namespace godot {
+
+// A Lua function wrapped as a Godot Callable. The function is pinned with a
+// registry reference, so calling it skips the name lookup of call_function()
+// and it can be stored, passed around and connected to signals directly.
+// The owning LuaBridge is referenced by ObjectID: once it is freed the
+// Callable becomes invalid and signal connections to it are dropped.
+class LuaCallable : public CallableCustom {
+    ObjectID bridge_id;
+    int ref;
+    const void *function_ptr;  // Identity of the Lua function, for equality and hashing
+    String text;
+
+    static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
+    static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
+
+public:
+    /**
+     * Wraps a function already pinned in the bridge's registry. Takes ownership of the reference.
+     */
+    LuaCallable(ObjectID p_bridge_id, int p_ref, const void *p_function_ptr, const String &p_text);
+    ~LuaCallable();
+
+    /**
+     * Returns the LuaCallable behind a Callable, or null if it wraps something else.
+     */
+    static const LuaCallable *from_callable(const Callable &p_callable);
+
+    ObjectID get_bridge_id() const { return bridge_id; }
+    int get_ref() const { return ref; }
+
+    uint32_t hash() const override;
+    String get_as_text() const override;
+    CompareEqualFunc get_compare_equal_func() const override;
+    CompareLessFunc get_compare_less_func() const override;
+    bool is_valid() const override;
+    ObjectID get_object() const override;
+    void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, GDExtensionCallError &r_call_error) const override;
+};
+
+} // namespace godot
+
+#endif // LUA_CALLABLE_H
@@ -0,0 +1,203 @@
+#include "lua_chunk_cache.h"
+#include "lua_log.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/hashing_context.hpp>
+#include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+
+#include <cstring>
+
+// Lua includes
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+using namespace godot;
+
+// Bumped when the key or file layout changes, so old entries are never read back
+static const char *CACHE_FORMAT = "godot-lua-bridge-chunk-1";
+
+// Scripts are streamed through fixed-size blocks, so memory stays bounded however large the file is
+static const int64_t BLOCK_SIZE = 64 * 1024;
+
+struct FileChunkReader {
+	Ref<FileAccess> file;
+	PackedByteArray block;
+};
+
+struct FileChunkWriter {
+	Ref<FileAccess> file;
+	PackedByteArray block;
+	int64_t used = 0;
+	bool failed = false;
+};
+
+static const char *read_file_block(lua_State *L, void *ud, size_t *r_size) {
+	FileChunkReader *reader = static_cast<FileChunkReader *>(ud);
+	reader->block = reader->file->get_buffer(BLOCK_SIZE);
+	*r_size = (size_t)reader->block.size();
+	return *r_size > 0 ? (const char *)reader->block.ptr() : nullptr;
+}
+
+static bool flush_block(FileChunkWriter &p_writer) {
+	if (p_writer.used > 0 && !p_writer.failed) {
+		p_writer.failed = !p_writer.file->store_buffer(p_writer.used == p_writer.block.size() ? p_writer.block : p_writer.block.slice(0, p_writer.used));
+	}
+	p_writer.used = 0;
+	return !p_writer.failed;
+}
+
+// lua_dump hands over many small pieces; they are gathered into blocks before reaching the file
+static int write_chunk(lua_State *L, const void *p_data, size_t p_size, void *ud) {
+	FileChunkWriter *writer = static_cast<FileChunkWriter *>(ud);
+	const uint8_t *data = static_cast<const uint8_t *>(p_data);
+	while (p_size > 0) {
+		if (writer->used == writer->block.size() && !flush_block(*writer)) {
+			return 1;
+		}
+		size_t length = MIN(p_size, (size_t)(writer->block.size() - writer->used));
+		memcpy(writer->block.ptrw() + writer->used, data, length);
+		writer->used += (int64_t)length;
+		data += length;
+		p_size -= length;
+	}
+	return 0;
+}
+
+// Offset where the chunk proper starts. Like luaL_loadfile, a UTF-8 BOM and a first line
+// starting with '#' are skipped; the comment's newline is kept so line numbers hold,
+// unless a binary chunk follows it directly.
+static uint64_t find_chunk_start(const Ref<FileAccess> &p_file) {
+	uint64_t length = p_file->get_length();
+	uint64_t start = 0;
+	if (length >= 3 && p_file->get_8() == 0xEF && p_file->get_8() == 0xBB && p_file->get_8() == 0xBF) {
+		start = 3;
+	}
+	p_file->seek(start);
+	if (start < length && p_file->get_8() == '#') {
+		uint64_t newline = start + 1;
+		while (newline < length && p_file->get_8() != '\n') {
+			newline++;
+		}
+		start = newline;
+		if (newline + 1 < length && p_file->get_8() == (uint8_t)LUA_SIGNATURE[0]) {
+			start = newline + 1;
+		}
+	}
+	return start;
+}
+
+static int load_stream(lua_State *L, const Ref<FileAccess> &p_file, uint64_t p_start, const CharString &p_chunkname, const char *p_mode) {
+	FileChunkReader reader;
+	reader.file = p_file;
+	p_file->seek(p_start);
+	return lua_load(L, read_file_block, &reader, p_chunkname.get_data(), p_mode);
+}
+
+String LuaChunkCache::get_cache_path(const Ref<FileAccess> &p_file, uint64_t p_start, const String &p_chunkname) {
+	Ref<HashingContext> context;
+	context.instantiate();
+	context->start(HashingContext::HASH_SHA256);
+	// The chunk name is part of the key: it is stored in the dump and shows up in error messages
+	context->update((String(CACHE_FORMAT) + "\n" + LUA_RELEASE + "\n" + p_chunkname + "\n").to_utf8_buffer());
+
+	p_file->seek(p_start);
+	for (;;) {
+		PackedByteArray block = p_file->get_buffer(BLOCK_SIZE);
+		if (block.is_empty()) {
+			break;
+		}
+		context->update(block);
+	}
+	return String(CACHE_DIR).path_join(context->finish().hex_encode() + ".luac");
+}
+
+int LuaChunkCache::load_file(lua_State *L, const String &p_path, const String &p_chunkname, bool p_use_cache, Stats *r_stats, const LuaLogFilter &p_log_filter) {
+	CharString chunkname = p_chunkname.utf8();
+	Ref<FileAccess> source = FileAccess::open(p_path, FileAccess::READ);
+	if (source.is_null()) {
+		lua_pushfstring(L, "cannot open %s", p_path.utf8().get_data());
+		return LUA_ERRFILE;
+	}
+	uint64_t start = find_chunk_start(source);
+	String cache_path;
+
+	if (p_use_cache) {
+		// Hashing streams the source once; on a hit it is never parsed
+		cache_path = get_cache_path(source, start, p_chunkname);
+		if (FileAccess::file_exists(cache_path)) {
+			Ref<FileAccess> cached = FileAccess::open(cache_path, FileAccess::READ);
+			int status = cached.is_valid() ? load_stream(L, cached, 0, chunkname, "b") : LUA_ERRFILE;
+			if (status == LUA_OK) {
+				if (r_stats) {
+					r_stats->hits++;
+				}
+				return LUA_OK;
+			}
+			if (status == LUA_ERRMEM) {
+				// Says nothing about the entry, and compiling from source would fail the same way
+				return status;
+			}
+			if (status == LUA_ERRSYNTAX) {
+				// Truncated file or a dump from an incompatible build: rebuild it from source
+				LUA_LOG_WARN(p_log_filter, LUA_LOG_MODS, "Discarding unusable bytecode cache entry " + cache_path + ": " + String(lua_tostring(L, -1)));
+				lua_pop(L, 1);
+				cached.unref();
+				DirAccess::remove_absolute(cache_path);
+			}
+		}
+		if (r_stats) {
+			r_stats->misses++;
+		}
+	}
+
+	// Text or binary chunk, as luaL_loadfile accepts
+	int status = load_stream(L, source, start, chunkname, nullptr);
+	if (status == LUA_OK && p_use_cache) {
+		store(L, cache_path, r_stats, p_log_filter);
+	}
+	return status;
+}
+
+void LuaChunkCache::store(lua_State *L, const String &p_path, Stats *r_stats, const LuaLogFilter &p_log_filter) {
+	DirAccess::make_dir_recursive_absolute(CACHE_DIR);
+	// Write to a temporary name first so a crash never leaves a truncated entry under the real key
+	String temp_path = p_path + ".tmp";
+	FileChunkWriter writer;
+	writer.file = FileAccess::open(temp_path, FileAccess::WRITE);
+	bool written = false;
+	if (writer.file.is_valid()) {
+		writer.block.resize(BLOCK_SIZE);
+		// Debug information is kept so errors still report file and line
+		written = lua_dump(L, write_chunk, &writer, 0) == 0 && flush_block(writer);
+		writer.file->close();
+		writer.file.unref();
+	}
+	if (!written || DirAccess::rename_absolute(temp_path, p_path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+		if (r_stats) {
+			r_stats->write_failures++;
+		}
+		LUA_LOG_DEBUG(p_log_filter, LUA_LOG_MODS, "Could not write bytecode cache entry " + p_path);
+		return;
+	}
+	LUA_LOG_DEBUG(p_log_filter, LUA_LOG_MODS, "Cached bytecode: " + p_path);
+}
+
+int LuaChunkCache::clear() {
+	Ref<DirAccess> dir = DirAccess::open(CACHE_DIR);
+	if (dir.is_null()) {
+		return 0;
+	}
+	int removed = 0;
+	PackedStringArray files = dir->get_files();
+	for (int64_t i = 0; i < files.size(); i++) {
+		if (dir->remove(files[i]) == OK) {
+			removed++;
+		}
+	}
+	return removed;
+}
@@ -0,0 +1,62 @@
+#ifndef LUA_CHUNK_CACHE_H
+#define LUA_CHUNK_CACHE_H
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+struct lua_State;
+
+namespace godot {
+
+struct LuaLogFilter;
+
+// Compiled-chunk cache for mod scripts. Chunks are dumped with lua_dump into
+// CACHE_DIR under the SHA-256 of the Lua release, the chunk name and the source
+// bytes, so an edited script (or a different Lua build) simply misses and is
+// recompiled: no invalidation step is needed. A cache file that is truncated or
+// from an incompatible build is deleted and rebuilt from source.
+//
+// Cached bytecode is trusted as-is (Lua does not verify binary chunks), so the
+// cache directory must not be writable by untrusted code.
+class LuaChunkCache {
+public:
+    static constexpr const char *CACHE_DIR = "user://lua_bytecode_cache";
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t write_failures = 0;
+    };
+
+    /**
+     * Compiles a script file and pushes it as a function, like luaL_loadfilex. The file is
+     * streamed into lua_load block by block, never held in memory whole. Text and binary
+     * chunks are accepted. On failure the error message is pushed instead.
+     * @param p_path The file path (res://, user:// or absolute).
+     * @param p_chunkname The chunk name, e.g. "@/path/to/script.lua".
+     * @param p_use_cache Whether to look up and store the compiled chunk in the cache.
+     * @param r_stats Counters updated by the lookup, may be null.
+     * @param p_log_filter Filter for cache diagnostics, normally the calling bridge's.
+     * @return A Lua status code (LUA_OK on success, LUA_ERRFILE if the file cannot be opened,
+     *         LUA_ERRMEM if the cached chunk could not be loaded for lack of memory).
+     */
+    static int load_file(lua_State *L, const String &p_path, const String &p_chunkname, bool p_use_cache, Stats *r_stats, const LuaLogFilter &p_log_filter);
+
+    /**
+     * Deletes every cached chunk.
+     * @return The number of files removed.
+     */
+    static int clear();
+
+private:
+    static String get_cache_path(const Ref<FileAccess> &p_file, uint64_t p_start, const String &p_chunkname);
+    static void store(lua_State *L, const String &p_path, Stats *r_stats, const LuaLogFilter &p_log_filter);
+};
+
+} // namespace godot
+
+#endif // LUA_CHUNK_CACHE_H
@@ -0,0 +1,106 @@
+#include "lua_log.h"
+
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+
+const LuaLogFilter LuaLog::default_filter;
+LuaLogRing *LuaLog::ring = nullptr;
+
+LuaLogRing::LuaLogRing(uint32_t p_capacity) {
+	// Round up to a power of two so positions wrap with a mask
+	size_t capacity = 2;
+	while (capacity < p_capacity) {
+		capacity <<= 1;
+	}
+	mask = capacity - 1;
+	cells.reset(new Cell[capacity]);
+	for (size_t i = 0; i < capacity; i++) {
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool LuaLogRing::push(Entry &&p_entry) {
+	size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+	Cell *cell;
+	for (;;) {
+		cell = &cells[pos & mask];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+		if (diff == 0) {
+			if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			// Full: never stall the producer
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		} else {
+			pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+	cell->entry = std::move(p_entry);
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+bool LuaLogRing::pop(Entry &r_entry) {
+	size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+	Cell *cell;
+	for (;;) {
+		cell = &cells[pos & mask];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+		if (diff == 0) {
+			if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false; // Empty
+		} else {
+			pos = dequeue_pos.load(std::memory_order_relaxed);
+		}
+	}
+	r_entry = std::move(cell->entry);
+	cell->entry.message = String();
+	cell->sequence.store(pos + mask + 1, std::memory_order_release);
+	return true;
+}
+
+void LuaLog::set_buffered(bool p_enabled, uint32_t p_capacity) {
+	LuaLogRing *old_ring = ring;
+	ring = p_enabled ? new LuaLogRing(p_capacity) : nullptr;
+	if (old_ring) {
+		// Write out whatever was still queued so nothing is lost on reconfiguration
+		LuaLogRing::Entry entry;
+		while (old_ring->pop(entry)) {
+			write_direct(entry.level, entry.is_lua_print ? "[Lua] " + entry.message : entry.message);
+		}
+		delete old_ring;
+	}
+}
+
+void LuaLog::write(uint32_t p_category, int p_level, const String &p_message) {
+	if (ring) {
+		LuaLogRing::Entry entry;
+		entry.level = p_level;
+		entry.message = p_message;
+		ring->push(std::move(entry));
+		return;
+	}
+	write_direct(p_level, p_message);
+}
+
+void LuaLog::write_direct(int p_level, const String &p_message) {
+	switch (p_level) {
+		case LUA_LOG_LEVEL_ERROR:
+			UtilityFunctions::printerr("[LuaBridge] " + p_message);
+			break;
+		case LUA_LOG_LEVEL_WARNING:
+			UtilityFunctions::print("[LuaBridge Warning] " + p_message);
+			break;
+		default:
+			UtilityFunctions::print("[LuaBridge] " + p_message);
+			break;
+	}
+}
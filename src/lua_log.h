@@ -0,0 +1,117 @@
+#ifndef LUA_LOG_H
+#define LUA_LOG_H
+
+#include <godot_cpp/variant/string.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Highest level compiled into the binary. Calls above it are removed by the
+// compiler, so release builds pay nothing for debug tracing.
+#ifndef LUA_BRIDGE_LOG_MAX_LEVEL
+#ifdef DEBUG_ENABLED
+#define LUA_BRIDGE_LOG_MAX_LEVEL 3
+#else
+#define LUA_BRIDGE_LOG_MAX_LEVEL 2
+#endif
+#endif
+
+namespace godot {
+
+enum LuaLogCategory : uint32_t {
+    LUA_LOG_BRIDGE = 1 << 0,      // Calls crossing between Lua and Godot
+    LUA_LOG_CONVERSION = 1 << 1,  // Variant <-> Lua value conversion
+    LUA_LOG_GC = 1 << 2,          // Object lifetime, garbage collection, state teardown
+    LUA_LOG_MODS = 1 << 3,        // Mod discovery, loading and lifecycle
+    LUA_LOG_RESOURCES = 1 << 4,   // Resource and scene loading
+    LUA_LOG_ALL = 0x1f,
+};
+
+enum LuaLogLevel : int {
+    LUA_LOG_LEVEL_ERROR = 0,
+    LUA_LOG_LEVEL_WARNING = 1,
+    LUA_LOG_LEVEL_INFO = 2,
+    LUA_LOG_LEVEL_DEBUG = 3,
+};
+
+// Bounded lock-free multi-producer queue (sequence-numbered cells). Producers
+// never block: when the ring is full the entry is dropped and counted.
+class LuaLogRing {
+public:
+    struct Entry {
+        int level = 0;
+        bool is_lua_print = false;
+        uint64_t source_id = 0;  // Instance id of the LuaBridge for Lua print entries
+        String message;
+    };
+
+    explicit LuaLogRing(uint32_t p_capacity);
+
+    bool push(Entry &&p_entry);
+    bool pop(Entry &r_entry);
+
+    uint32_t get_capacity() const { return (uint32_t)(mask + 1); }
+    uint64_t get_dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Entry entry;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> enqueue_pos{ 0 };
+    alignas(64) std::atomic<size_t> dequeue_pos{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+};
+
+// Runtime level and category mask. Each LuaBridge owns one, so its settings only affect
+// its own output; code running outside a bridge logs through LuaLog::default_filter.
+struct LuaLogFilter {
+    uint32_t categories = LUA_LOG_ALL;
+    int level = LUA_LOG_LEVEL_INFO;
+
+    bool is_enabled(uint32_t p_category, int p_level) const {
+        return p_level <= level && (categories & p_category) != 0;
+    }
+};
+
+// Output side of the log, shared by every bridge: the console and the optional ring buffer.
+class LuaLog {
+    static LuaLogRing *ring;
+
+public:
+    static const LuaLogFilter default_filter;
+
+    static void write(uint32_t p_category, int p_level, const String &p_message);
+    // Writes an entry to the console immediately, bypassing the ring
+    static void write_direct(int p_level, const String &p_message);
+
+    // Buffered mode: entries go into the ring and are written when drained.
+    // Only reconfigure from the main thread while no other thread is logging.
+    static void set_buffered(bool p_enabled, uint32_t p_capacity);
+    static bool is_buffered() { return ring != nullptr; }
+    static LuaLogRing *get_ring() { return ring; }
+};
+
+} // namespace godot
+
+// m_filter is the LuaLogFilter to check, usually the bridge's own. The message expression
+// is only evaluated when the category and level are enabled.
+#define LUA_LOG(m_filter, m_category, m_level, m_message)                           \
+    do {                                                                            \
+        if ((m_level) <= LUA_BRIDGE_LOG_MAX_LEVEL &&                                \
+                (m_filter).is_enabled((m_category), (m_level))) {                   \
+            ::godot::LuaLog::write((m_category), (m_level), (m_message));           \
+        }                                                                           \
+    } while (0)
+
+#define LUA_LOG_ERROR(m_filter, m_category, m_message) LUA_LOG(m_filter, m_category, ::godot::LUA_LOG_LEVEL_ERROR, m_message)
+#define LUA_LOG_WARN(m_filter, m_category, m_message) LUA_LOG(m_filter, m_category, ::godot::LUA_LOG_LEVEL_WARNING, m_message)
+#define LUA_LOG_INFO(m_filter, m_category, m_message) LUA_LOG(m_filter, m_category, ::godot::LUA_LOG_LEVEL_INFO, m_message)
+#define LUA_LOG_DEBUG(m_filter, m_category, m_message) LUA_LOG(m_filter, m_category, ::godot::LUA_LOG_LEVEL_DEBUG, m_message)
+
+#endif // LUA_LOG_H
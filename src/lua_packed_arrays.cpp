@@ -0,0 +1,368 @@
+#include "lua_packed_arrays.h"
+#include "lua_value_types.h"
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+
+#include <cstdint>
+#include <new>
+
+// Lua includes
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+using namespace godot;
+
+template <typename A>
+struct PackedType;
+
+template <>
+struct PackedType<PackedByteArray> {
+	using Element = uint8_t;
+	static constexpr const char *name = "PackedByteArray";
+	static constexpr const char *element_name = "integer in 0..255";
+
+	static void push(lua_State *L, uint8_t value) { lua_pushinteger(L, value); }
+	// Out-of-range values are rejected rather than wrapped
+	static bool to(lua_State *L, int index, uint8_t &r_value) {
+		int is_int = 0;
+		lua_Integer value = lua_tointegerx(L, index, &is_int);
+		if (!is_int || value < 0 || value > UINT8_MAX) {
+			return false;
+		}
+		r_value = (uint8_t)value;
+		return true;
+	}
+};
+
+template <>
+struct PackedType<PackedInt32Array> {
+	using Element = int32_t;
+	static constexpr const char *name = "PackedInt32Array";
+	static constexpr const char *element_name = "32-bit integer";
+
+	static void push(lua_State *L, int32_t value) { lua_pushinteger(L, value); }
+	static bool to(lua_State *L, int index, int32_t &r_value) {
+		int is_int = 0;
+		lua_Integer value = lua_tointegerx(L, index, &is_int);
+		if (!is_int || value < INT32_MIN || value > INT32_MAX) {
+			return false;
+		}
+		r_value = (int32_t)value;
+		return true;
+	}
+};
+
+template <>
+struct PackedType<PackedFloat32Array> {
+	using Element = float;
+	static constexpr const char *name = "PackedFloat32Array";
+	static constexpr const char *element_name = "number";
+
+	static void push(lua_State *L, float value) { lua_pushnumber(L, value); }
+	static bool to(lua_State *L, int index, float &r_value) {
+		int is_num = 0;
+		r_value = (float)lua_tonumberx(L, index, &is_num);
+		return is_num;
+	}
+};
+
+template <>
+struct PackedType<PackedVector2Array> {
+	using Element = Vector2;
+	static constexpr const char *name = "PackedVector2Array";
+	static constexpr const char *element_name = "Vector2";
+
+	static void push(lua_State *L, const Vector2 &value) { lua_push_value(L, value); }
+	static bool to(lua_State *L, int index, Vector2 &r_value) {
+		Vector2 *v = lua_test_value<Vector2>(L, index);
+		if (!v) {
+			return false;
+		}
+		r_value = *v;
+		return true;
+	}
+};
+
+// Packed arrays own a refcounted buffer, so views need __gc. Assigning or copying
+// the array only takes a reference; the buffer is duplicated on the first write.
+template <typename A>
+static A *push_packed(lua_State *L, const A &p_array) {
+	A *ud = static_cast<A *>(lua_newuserdatauv(L, sizeof(A), 0));
+	new (ud) A(p_array);
+	luaL_setmetatable(L, PackedType<A>::name);
+	return ud;
+}
+
+template <typename A>
+static A &check_packed(lua_State *L, int index) {
+	return *static_cast<A *>(luaL_checkudata(L, index, PackedType<A>::name));
+}
+
+// Writes the sequence part of the table at table_index into the array starting
+// at offset (0-based), growing the array when needed. Uses one ptrw() for the
+// whole copy instead of a copy-on-write check per element.
+template <typename A>
+static void fill_from_table(lua_State *L, A &array, int table_index, int64_t offset) {
+	using Element = typename PackedType<A>::Element;
+	int64_t count = (int64_t)lua_rawlen(L, table_index);
+	if (offset + count > array.size()) {
+		array.resize(offset + count);
+	}
+	if (count == 0) {
+		return;
+	}
+	Element *w = array.ptrw() + offset;
+	for (int64_t i = 0; i < count; i++) {
+		lua_rawgeti(L, table_index, i + 1);
+		if (!PackedType<A>::to(L, -1, w[i])) {
+			luaL_error(L, "%s.copy_from: element %I is %s, expected %s", PackedType<A>::name,
+					(lua_Integer)(i + 1), luaL_typename(L, -1), PackedType<A>::element_name);
+		}
+		lua_pop(L, 1);
+	}
+}
+
+// Metamethods -----------------------------------------------------------------
+
+template <typename A>
+static int packed_index(lua_State *L) {
+	const A &array = check_packed<A>(L, 1);
+	if (lua_type(L, 2) == LUA_TNUMBER) {
+		lua_Integer i = lua_tointeger(L, 2);
+		if (i >= 1 && i <= array.size()) {
+			PackedType<A>::push(L, array.ptr()[i - 1]);
+		} else {
+			lua_pushnil(L);
+		}
+		return 1;
+	}
+	// Methods live in the table bound as upvalue 1
+	lua_pushvalue(L, 2);
+	lua_rawget(L, lua_upvalueindex(1));
+	return 1;
+}
+
+template <typename A>
+static int packed_newindex(lua_State *L) {
+	A &array = check_packed<A>(L, 1);
+	lua_Integer i = luaL_checkinteger(L, 2);
+	typename PackedType<A>::Element value;
+	if (!PackedType<A>::to(L, 3, value)) {
+		return luaL_typeerror(L, 3, PackedType<A>::element_name);
+	}
+
+	int64_t size = array.size();
+	if (i >= 1 && i <= size) {
+		array.ptrw()[i - 1] = value;
+	} else if (i == size + 1) {
+		array.push_back(value);
+	} else {
+		return luaL_error(L, "%s index %I out of range (size %I)", PackedType<A>::name, i, (lua_Integer)size);
+	}
+	return 0;
+}
+
+template <typename A>
+static int packed_len(lua_State *L) {
+	lua_pushinteger(L, check_packed<A>(L, 1).size());
+	return 1;
+}
+
+template <typename A>
+static int packed_gc(lua_State *L) {
+	static_cast<A *>(lua_touserdata(L, 1))->~A();
+	return 0;
+}
+
+template <typename A>
+static int packed_tostring(lua_State *L) {
+	lua_pushfstring(L, "%s[%I]", PackedType<A>::name, (lua_Integer)check_packed<A>(L, 1).size());
+	return 1;
+}
+
+// Methods ---------------------------------------------------------------------
+
+template <typename A>
+static int packed_size(lua_State *L) {
+	lua_pushinteger(L, check_packed<A>(L, 1).size());
+	return 1;
+}
+
+template <typename A>
+static int packed_resize(lua_State *L) {
+	A &array = check_packed<A>(L, 1);
+	lua_Integer size = luaL_checkinteger(L, 2);
+	luaL_argcheck(L, size >= 0, 2, "size must not be negative");
+	array.resize(size);
+	return 0;
+}
+
+// view:copy_from(source[, start]): source is a table or a view of the same type
+template <typename A>
+static int packed_copy_from(lua_State *L) {
+	A &array = check_packed<A>(L, 1);
+	lua_Integer start = luaL_optinteger(L, 3, 1);
+	luaL_argcheck(L, start >= 1, 3, "start must be at least 1");
+
+	if (A *source = static_cast<A *>(luaL_testudata(L, 2, PackedType<A>::name))) {
+		if (start == 1 && source->size() >= array.size()) {
+			// Whole-buffer replace just shares the source buffer
+			array = *source;
+			return 0;
+		}
+		int64_t count = source->size();
+		if (start - 1 + count > array.size()) {
+			array.resize(start - 1 + count);
+		}
+		if (count > 0) {
+			typename PackedType<A>::Element *w = array.ptrw() + (start - 1);
+			const typename PackedType<A>::Element *r = source->ptr();
+			// Backwards, so copying a view into itself at a later start is safe
+			for (int64_t i = count - 1; i >= 0; i--) {
+				w[i] = r[i];
+			}
+		}
+		return 0;
+	}
+
+	luaL_checktype(L, 2, LUA_TTABLE);
+	fill_from_table(L, array, 2, start - 1);
+	return 0;
+}
+
+// view:copy_to([table[, start]]): writes every element into the table (a new one
+// if none is given) starting at start, and returns the table
+template <typename A>
+static int packed_copy_to(lua_State *L) {
+	A &array = check_packed<A>(L, 1);
+	int64_t count = array.size();
+	lua_Integer start = 1;
+	if (lua_isnoneornil(L, 2)) {
+		lua_settop(L, 1);
+		lua_createtable(L, (int)count, 0);
+	} else {
+		luaL_checktype(L, 2, LUA_TTABLE);
+		start = luaL_optinteger(L, 3, 1);
+		lua_settop(L, 2);
+	}
+
+	if (count > 0) {
+		const typename PackedType<A>::Element *r = array.ptr();
+		for (int64_t i = 0; i < count; i++) {
+			PackedType<A>::push(L, r[i]);
+			lua_rawseti(L, 2, start + i);
+		}
+	}
+	return 1;
+}
+
+template <typename A>
+static int packed_duplicate(lua_State *L) {
+	push_packed(L, check_packed<A>(L, 1).duplicate());
+	return 1;
+}
+
+// PackedFloat32Array(), PackedFloat32Array(size) or PackedFloat32Array(table)
+template <typename A>
+static int packed_new(lua_State *L) {
+	// Build in place on the Lua stack so a conversion error cannot leak a C++ temporary
+	A &array = *push_packed(L, A());
+	if (lua_type(L, 1) == LUA_TTABLE) {
+		fill_from_table(L, array, 1, 0);
+	} else if (!lua_isnoneornil(L, 1)) {
+		lua_Integer size = luaL_checkinteger(L, 1);
+		luaL_argcheck(L, size >= 0, 1, "size must not be negative");
+		array.resize(size);
+	}
+	return 1;
+}
+
+// Registration ----------------------------------------------------------------
+
+template <typename A>
+static void register_packed_array(lua_State *L) {
+	static const luaL_Reg methods[] = {
+		{ "size", packed_size<A> },
+		{ "resize", packed_resize<A> },
+		{ "copy_from", packed_copy_from<A> },
+		{ "copy_to", packed_copy_to<A> },
+		{ "duplicate", packed_duplicate<A> },
+		{ nullptr, nullptr }
+	};
+
+	luaL_newmetatable(L, PackedType<A>::name);
+
+	// Hidden from getmetatable() like the value types, so scripts cannot edit it
+	lua_pushstring(L, PackedType<A>::name);
+	lua_setfield(L, -2, "__metatable");
+
+	lua_newtable(L);
+	luaL_setfuncs(L, methods, 0);
+	lua_pushcclosure(L, packed_index<A>, 1);
+	lua_setfield(L, -2, "__index");
+
+	lua_pushcfunction(L, packed_newindex<A>);
+	lua_setfield(L, -2, "__newindex");
+	lua_pushcfunction(L, packed_len<A>);
+	lua_setfield(L, -2, "__len");
+	lua_pushcfunction(L, packed_gc<A>);
+	lua_setfield(L, -2, "__gc");
+	lua_pushcfunction(L, packed_tostring<A>);
+	lua_setfield(L, -2, "__tostring");
+	lua_pop(L, 1);
+
+	lua_pushcfunction(L, packed_new<A>);
+	lua_setglobal(L, PackedType<A>::name);
+}
+
+void godot::lua_register_packed_arrays(lua_State *L) {
+	register_packed_array<PackedByteArray>(L);
+	register_packed_array<PackedInt32Array>(L);
+	register_packed_array<PackedFloat32Array>(L);
+	register_packed_array<PackedVector2Array>(L);
+}
+
+bool godot::lua_push_packed_array(lua_State *L, const Variant &value) {
+	switch (value.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			push_packed(L, (PackedByteArray)value);
+			return true;
+		case Variant::PACKED_INT32_ARRAY:
+			push_packed(L, (PackedInt32Array)value);
+			return true;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			push_packed(L, (PackedFloat32Array)value);
+			return true;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			push_packed(L, (PackedVector2Array)value);
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Identified by metatable, as the copy_from fast path does
+template <typename A>
+static bool to_variant(lua_State *L, int index, Variant &r_value) {
+	A *array = static_cast<A *>(luaL_testudata(L, index, PackedType<A>::name));
+	if (!array) {
+		return false;
+	}
+	r_value = *array;
+	return true;
+}
+
+bool godot::lua_to_packed_array(lua_State *L, int index, Variant &r_value) {
+	if (lua_type(L, index) != LUA_TUSERDATA) {
+		return false;
+	}
+	return to_variant<PackedByteArray>(L, index, r_value) ||
+			to_variant<PackedInt32Array>(L, index, r_value) ||
+			to_variant<PackedFloat32Array>(L, index, r_value) ||
+			to_variant<PackedVector2Array>(L, index, r_value);
+}
@@ -0,0 +1,38 @@
+#ifndef LUA_PACKED_ARRAYS_H
+#define LUA_PACKED_ARRAYS_H
+
+#include <godot_cpp/variant/variant.hpp>
+
+// Forward declarations
+struct lua_State;
+
+namespace godot {
+
+// PackedByteArray, PackedInt32Array, PackedFloat32Array and PackedVector2Array
+// are exposed as userdata views holding the packed array itself. Packed arrays
+// are copy-on-write, so a view shares the Godot buffer until either side writes.
+// Views are 1-based like Lua sequences: v[i], v[#v + 1] = x appends, #v is the
+// size, and v:copy_from(table) / v:copy_to([table]) move data in bulk. Elements
+// outside the element type's range (300 for a byte) raise an error instead of wrapping.
+
+/**
+ * Registers the packed array view metatables and their constructor globals
+ * (PackedFloat32Array([size | table]), ...).
+ */
+void lua_register_packed_arrays(lua_State *L);
+
+/**
+ * Pushes a packed array Variant as a view.
+ * @return False (and nothing pushed) if the Variant is not a supported packed array.
+ */
+bool lua_push_packed_array(lua_State *L, const Variant &value);
+
+/**
+ * Reads a packed array view at the given stack index.
+ * @return False if the value is not a packed array view.
+ */
+bool lua_to_packed_array(lua_State *L, int index, Variant &r_value);
+
+} // namespace godot
+
+#endif // LUA_PACKED_ARRAYS_H
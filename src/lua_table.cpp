@@ -0,0 +1,192 @@
+#include "lua_table.h"
+#include "bridge.h"
+
+// Lua includes
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+using namespace godot;
+
+void LuaTable::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("is_valid"), &LuaTable::is_valid);
+	ClassDB::bind_method(D_METHOD("get_value", "key"), &LuaTable::get_value);
+	ClassDB::bind_method(D_METHOD("set_value", "key", "value"), &LuaTable::set_value);
+	ClassDB::bind_method(D_METHOD("has", "key"), &LuaTable::has);
+	ClassDB::bind_method(D_METHOD("size"), &LuaTable::size);
+	ClassDB::bind_method(D_METHOD("keys"), &LuaTable::keys);
+	ClassDB::bind_method(D_METHOD("to_dictionary"), &LuaTable::to_dictionary);
+	ClassDB::bind_method(D_METHOD("_iter_init", "iter"), &LuaTable::_iter_init);
+	ClassDB::bind_method(D_METHOD("_iter_next", "iter"), &LuaTable::_iter_next);
+	ClassDB::bind_method(D_METHOD("_iter_get", "iter"), &LuaTable::_iter_get);
+}
+
+LuaTable::LuaTable() {
+}
+
+LuaTable::~LuaTable() {
+	if (is_valid()) {
+		luaL_unref(bridge->L, LUA_REGISTRYINDEX, ref);
+	}
+	ref = LUA_NOREF;
+}
+
+void LuaTable::setup(const Ref<LuaBridge> &p_bridge, int p_ref) {
+	bridge = p_bridge;
+	ref = p_ref;
+}
+
+bool LuaTable::is_valid() const {
+	return bridge.is_valid() && bridge->L && !bridge->is_cleaning_up && ref != LUA_NOREF && ref != LUA_REFNIL;
+}
+
+bool LuaTable::push_table() const {
+	if (!is_valid()) {
+		return false;
+	}
+	lua_rawgeti(bridge->L, LUA_REGISTRYINDEX, ref);
+	return true;
+}
+
+bool LuaTable::_get(const StringName &p_name, Variant &r_ret) const {
+	if (!push_table()) {
+		return false;
+	}
+	lua_State *L = bridge->L;
+	lua_pushstring(L, String(p_name).utf8().get_data());
+	if (lua_rawget(L, -2) == LUA_TNIL) {
+		// Not a table field: let Object resolve regular properties
+		lua_pop(L, 2);
+		return false;
+	}
+	r_ret = bridge->lua_to_godot_lazy(L, -1);
+	lua_pop(L, 2);
+	return true;
+}
+
+bool LuaTable::_set(const StringName &p_name, const Variant &p_value) {
+	// Only fields the table already holds: anything else (script, metadata/*) is an Object
+	// property, and new fields are added with set_value
+	if (!has(String(p_name))) {
+		return false;
+	}
+	set_value(String(p_name), p_value);
+	return true;
+}
+
+Variant LuaTable::get_value(const Variant &key) const {
+	if (!push_table()) {
+		return Variant();
+	}
+	lua_State *L = bridge->L;
+	bridge->godot_to_lua(L, key);
+	lua_rawget(L, -2);
+	Variant result = bridge->lua_to_godot_lazy(L, -1);
+	lua_pop(L, 2);
+	return result;
+}
+
+void LuaTable::set_value(const Variant &key, const Variant &value) {
+	if (!push_table()) {
+		return;
+	}
+	lua_State *L = bridge->L;
+	bridge->godot_to_lua(L, key);
+	lua_Number numeric_key = lua_tonumber(L, -1);
+	if (lua_isnil(L, -1) || numeric_key != numeric_key) {
+		// nil and NaN cannot be table keys (lua_rawset would raise)
+		lua_pop(L, 2);
+		bridge->log_error("LuaTable.set_value: invalid key of type " + Variant::get_type_name(key.get_type()));
+		return;
+	}
+	bridge->godot_to_lua(L, value);
+	lua_rawset(L, -3);
+	lua_pop(L, 1);
+}
+
+bool LuaTable::has(const Variant &key) const {
+	if (!push_table()) {
+		return false;
+	}
+	lua_State *L = bridge->L;
+	bridge->godot_to_lua(L, key);
+	bool found = lua_rawget(L, -2) != LUA_TNIL;
+	lua_pop(L, 2);
+	return found;
+}
+
+int64_t LuaTable::size() const {
+	if (!push_table()) {
+		return 0;
+	}
+	int64_t length = (int64_t)lua_rawlen(bridge->L, -1);
+	lua_pop(bridge->L, 1);
+	return length;
+}
+
+Array LuaTable::keys() const {
+	Array result;
+	if (!push_table()) {
+		return result;
+	}
+	lua_State *L = bridge->L;
+	int table_index = lua_gettop(L);
+	lua_pushnil(L);
+	while (lua_next(L, table_index)) {
+		result.append(bridge->lua_to_godot_lazy(L, -2));
+		lua_pop(L, 1); // pop value, keep key for next iteration
+	}
+	lua_pop(L, 1);
+	return result;
+}
+
+Dictionary LuaTable::to_dictionary() const {
+	if (!push_table()) {
+		return Dictionary();
+	}
+	Variant copy = bridge->lua_to_godot(bridge->L, -1);
+	lua_pop(bridge->L, 1);
+
+	if (copy.get_type() == Variant::ARRAY) {
+		Array arr = copy;
+		Dictionary dict;
+		for (int64_t i = 0; i < arr.size(); i++) {
+			dict[i + 1] = arr[i];
+		}
+		return dict;
+	}
+	return copy;
+}
+
+// The iterator state is [keys, position]: keys are captured when the loop starts,
+// so mutating the table inside the loop does not break the walk.
+bool LuaTable::_iter_init(const Array &p_iter) {
+	Array table_keys = keys();
+	if (table_keys.is_empty()) {
+		return false;
+	}
+	Array state;
+	state.append(table_keys);
+	state.append(0);
+	Array iter = p_iter;
+	iter[0] = state;
+	return true;
+}
+
+bool LuaTable::_iter_next(const Array &p_iter) {
+	Array iter = p_iter;
+	Array state = iter[0];
+	int64_t position = (int64_t)state[1] + 1;
+	if (position >= ((Array)state[0]).size()) {
+		return false;
+	}
+	state[1] = position;
+	return true;
+}
+
+Variant LuaTable::_iter_get(const Variant &p_iter) {
+	Array state = p_iter;
+	Array table_keys = state[0];
+	return table_keys[(int64_t)state[1]];
+}
@@ -0,0 +1,107 @@
+#ifndef LUA_TABLE_H
+#define LUA_TABLE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+namespace godot {
+
+class LuaBridge;
+
+// Lazy view of a Lua table, returned by LuaBridge when table proxies are enabled.
+// The table stays in the Lua state (pinned by a registry reference) and fields
+// are converted only when read, so inspecting one field of a large table costs
+// one lookup instead of a deep copy. Access is raw: metamethods are not invoked.
+class LuaTable : public RefCounted {
+    GDCLASS(LuaTable, RefCounted)
+
+private:
+    Ref<LuaBridge> bridge;
+    int ref = -2;  // LUA_NOREF
+
+    bool push_table() const;
+
+protected:
+    static void _bind_methods();
+
+    // Lets GDScript read and write existing string keys as properties: table.hp, table.get("hp").
+    // Other names fall through to Object, so set_meta() and set_script() keep working.
+    bool _get(const StringName &p_name, Variant &r_ret) const;
+    bool _set(const StringName &p_name, const Variant &p_value);
+
+public:
+    /**
+     * Constructs an unbound LuaTable. Tables are created by LuaBridge.
+     */
+    LuaTable();
+    /**
+     * Releases the registry reference so Lua can collect the table.
+     */
+    ~LuaTable();
+
+    /**
+     * Binds the proxy to a table already pinned in the bridge's registry.
+     * Takes ownership of the reference.
+     */
+    void setup(const Ref<LuaBridge> &p_bridge, int p_ref);
+    /**
+     * Gets the registry reference of the table (internal).
+     */
+    int get_ref() const { return ref; }
+    /**
+     * Gets the bridge that owns the table (internal).
+     */
+    LuaBridge *get_bridge() const { return bridge.ptr(); }
+
+    /**
+     * Checks whether the table is still reachable (its Lua state is alive).
+     * @return True if the table can be accessed.
+     */
+    bool is_valid() const;
+    /**
+     * Reads a field. Nested tables come back as LuaTable proxies.
+     * @param key The key (string, integer, float or bool).
+     * @return The value, or null if the field is absent.
+     */
+    Variant get_value(const Variant &key) const;
+    /**
+     * Writes a field. Assigning null removes it.
+     * @param key The key (string, integer, float or bool).
+     * @param value The value to store.
+     */
+    void set_value(const Variant &key, const Variant &value);
+    /**
+     * Checks whether a field is present.
+     * @param key The key.
+     * @return True if the field is not nil.
+     */
+    bool has(const Variant &key) const;
+    /**
+     * Gets the length of the sequence part (the # operator without metamethods).
+     * @return The sequence length.
+     */
+    int64_t size() const;
+    /**
+     * Gets all keys of the table without converting the values.
+     * @return The keys.
+     */
+    Array keys() const;
+    /**
+     * Deep-copies the whole table. Sequence entries are keyed 1..n.
+     * @return The table contents.
+     */
+    Dictionary to_dictionary() const;
+
+    // Iteration over keys: for key in table
+    bool _iter_init(const Array &p_iter);
+    bool _iter_next(const Array &p_iter);
+    Variant _iter_get(const Variant &p_iter);
+};
+
+} // namespace godot
+
+#endif // LUA_TABLE_H
@@ -0,0 +1,754 @@
+#include "lua_value_types.h"
+
+#include <godot_cpp/variant/basis.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/transform2d.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <cstring>
+#include <new>
+
+// Lua includes
+extern "C" {
+#include "lua.h"
+#include "lauxlib.h"
+}
+
+using namespace godot;
+
+template <typename T>
+struct ValueType;
+
+template <>
+struct ValueType<Vector2> {
+	static constexpr const char *name = "Vector2";
+};
+
+template <>
+struct ValueType<Vector3> {
+	static constexpr const char *name = "Vector3";
+};
+
+template <>
+struct ValueType<Color> {
+	static constexpr const char *name = "Color";
+};
+
+template <>
+struct ValueType<Rect2> {
+	static constexpr const char *name = "Rect2";
+};
+
+template <>
+struct ValueType<Transform2D> {
+	static constexpr const char *name = "Transform2D";
+};
+
+template <>
+struct ValueType<Basis> {
+	static constexpr const char *name = "Basis";
+};
+
+template <>
+struct ValueType<Transform3D> {
+	static constexpr const char *name = "Transform3D";
+};
+
+template <typename T>
+static T *push_value(lua_State *L, const T &p_value) {
+	T *ud = static_cast<T *>(lua_newuserdatauv(L, sizeof(T), 0));
+	new (ud) T(p_value);
+	luaL_setmetatable(L, ValueType<T>::name);
+	return ud;
+}
+
+template <typename T>
+static T *test_value(lua_State *L, int index) {
+	return static_cast<T *>(luaL_testudata(L, index, ValueType<T>::name));
+}
+
+template <typename T>
+static T &check_value(lua_State *L, int index) {
+	return *static_cast<T *>(luaL_checkudata(L, index, ValueType<T>::name));
+}
+
+static real_t check_real(lua_State *L, int index) {
+	return (real_t)luaL_checknumber(L, index);
+}
+
+// Field access ----------------------------------------------------------------
+
+static bool push_field(lua_State *L, const Vector2 &v, const char *key) {
+	if (strcmp(key, "x") == 0) {
+		lua_pushnumber(L, v.x);
+	} else if (strcmp(key, "y") == 0) {
+		lua_pushnumber(L, v.y);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool push_field(lua_State *L, const Vector3 &v, const char *key) {
+	if (strcmp(key, "x") == 0) {
+		lua_pushnumber(L, v.x);
+	} else if (strcmp(key, "y") == 0) {
+		lua_pushnumber(L, v.y);
+	} else if (strcmp(key, "z") == 0) {
+		lua_pushnumber(L, v.z);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool push_field(lua_State *L, const Color &c, const char *key) {
+	if (strcmp(key, "r") == 0) {
+		lua_pushnumber(L, c.r);
+	} else if (strcmp(key, "g") == 0) {
+		lua_pushnumber(L, c.g);
+	} else if (strcmp(key, "b") == 0) {
+		lua_pushnumber(L, c.b);
+	} else if (strcmp(key, "a") == 0) {
+		lua_pushnumber(L, c.a);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool push_field(lua_State *L, const Rect2 &r, const char *key) {
+	if (strcmp(key, "position") == 0) {
+		push_value(L, r.position);
+	} else if (strcmp(key, "size") == 0) {
+		push_value(L, r.size);
+	} else if (strcmp(key, "end") == 0) {
+		push_value(L, r.get_end());
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool push_field(lua_State *L, const Transform2D &t, const char *key) {
+	if (strcmp(key, "x") == 0) {
+		push_value(L, t.columns[0]);
+	} else if (strcmp(key, "y") == 0) {
+		push_value(L, t.columns[1]);
+	} else if (strcmp(key, "origin") == 0) {
+		push_value(L, t.columns[2]);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool push_field(lua_State *L, const Basis &b, const char *key) {
+	if (strcmp(key, "x") == 0) {
+		push_value(L, b.get_column(0));
+	} else if (strcmp(key, "y") == 0) {
+		push_value(L, b.get_column(1));
+	} else if (strcmp(key, "z") == 0) {
+		push_value(L, b.get_column(2));
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static bool push_field(lua_State *L, const Transform3D &t, const char *key) {
+	if (strcmp(key, "basis") == 0) {
+		push_value(L, t.basis);
+	} else if (strcmp(key, "origin") == 0) {
+		push_value(L, t.origin);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+template <typename T>
+static int value_index(lua_State *L) {
+	const T &value = check_value<T>(L, 1);
+	if (lua_type(L, 2) == LUA_TSTRING && push_field(L, value, lua_tostring(L, 2))) {
+		return 1;
+	}
+	// Methods live in the table bound as upvalue 1
+	lua_pushvalue(L, 2);
+	lua_rawget(L, lua_upvalueindex(1));
+	return 1;
+}
+
+template <typename T>
+static int value_newindex(lua_State *L) {
+	// Value types keep Godot's copy semantics: build a new value instead of mutating a shared one
+	return luaL_error(L, "%s is immutable; construct a new value instead of assigning '%s'",
+			ValueType<T>::name, luaL_tolstring(L, 2, nullptr));
+}
+
+template <typename T>
+static int value_eq(lua_State *L) {
+	T *a = test_value<T>(L, 1);
+	T *b = test_value<T>(L, 2);
+	lua_pushboolean(L, a && b && *a == *b);
+	return 1;
+}
+
+// Arithmetic ------------------------------------------------------------------
+
+template <typename T>
+static int value_add(lua_State *L) {
+	push_value(L, check_value<T>(L, 1) + check_value<T>(L, 2));
+	return 1;
+}
+
+template <typename T>
+static int value_sub(lua_State *L) {
+	push_value(L, check_value<T>(L, 1) - check_value<T>(L, 2));
+	return 1;
+}
+
+template <typename T>
+static int value_unm(lua_State *L) {
+	push_value(L, -check_value<T>(L, 1));
+	return 1;
+}
+
+// Scalar on either side, or component-wise with another value of the same type
+template <typename T>
+static int value_mul(lua_State *L) {
+	if (lua_type(L, 1) == LUA_TNUMBER) {
+		push_value(L, check_value<T>(L, 2) * (real_t)lua_tonumber(L, 1));
+	} else if (lua_type(L, 2) == LUA_TNUMBER) {
+		push_value(L, check_value<T>(L, 1) * (real_t)lua_tonumber(L, 2));
+	} else {
+		push_value(L, check_value<T>(L, 1) * check_value<T>(L, 2));
+	}
+	return 1;
+}
+
+template <typename T>
+static int value_div(lua_State *L) {
+	if (lua_type(L, 2) == LUA_TNUMBER) {
+		push_value(L, check_value<T>(L, 1) / (real_t)lua_tonumber(L, 2));
+	} else {
+		push_value(L, check_value<T>(L, 1) / check_value<T>(L, 2));
+	}
+	return 1;
+}
+
+// Transform * Transform composes, Transform * vector transforms the vector
+template <typename T, typename V>
+static int transform_mul(lua_State *L) {
+	const T &t = check_value<T>(L, 1);
+	if (V *v = test_value<V>(L, 2)) {
+		push_value(L, t.xform(*v));
+	} else {
+		push_value(L, t * check_value<T>(L, 2));
+	}
+	return 1;
+}
+
+// String conversion -----------------------------------------------------------
+
+static int vector2_tostring(lua_State *L) {
+	const Vector2 &v = check_value<Vector2>(L, 1);
+	lua_pushfstring(L, "(%f, %f)", (lua_Number)v.x, (lua_Number)v.y);
+	return 1;
+}
+
+static int vector3_tostring(lua_State *L) {
+	const Vector3 &v = check_value<Vector3>(L, 1);
+	lua_pushfstring(L, "(%f, %f, %f)", (lua_Number)v.x, (lua_Number)v.y, (lua_Number)v.z);
+	return 1;
+}
+
+static int color_tostring(lua_State *L) {
+	const Color &c = check_value<Color>(L, 1);
+	lua_pushfstring(L, "(%f, %f, %f, %f)", (lua_Number)c.r, (lua_Number)c.g, (lua_Number)c.b, (lua_Number)c.a);
+	return 1;
+}
+
+static int rect2_tostring(lua_State *L) {
+	const Rect2 &r = check_value<Rect2>(L, 1);
+	lua_pushfstring(L, "[P: (%f, %f), S: (%f, %f)]", (lua_Number)r.position.x, (lua_Number)r.position.y,
+			(lua_Number)r.size.x, (lua_Number)r.size.y);
+	return 1;
+}
+
+static int transform2d_tostring(lua_State *L) {
+	const Transform2D &t = check_value<Transform2D>(L, 1);
+	lua_pushfstring(L, "[X: (%f, %f), Y: (%f, %f), O: (%f, %f)]",
+			(lua_Number)t.columns[0].x, (lua_Number)t.columns[0].y,
+			(lua_Number)t.columns[1].x, (lua_Number)t.columns[1].y,
+			(lua_Number)t.columns[2].x, (lua_Number)t.columns[2].y);
+	return 1;
+}
+
+static void push_basis_string(lua_State *L, const Basis &b) {
+	Vector3 x = b.get_column(0);
+	Vector3 y = b.get_column(1);
+	Vector3 z = b.get_column(2);
+	lua_pushfstring(L, "[X: (%f, %f, %f), Y: (%f, %f, %f), Z: (%f, %f, %f)]",
+			(lua_Number)x.x, (lua_Number)x.y, (lua_Number)x.z,
+			(lua_Number)y.x, (lua_Number)y.y, (lua_Number)y.z,
+			(lua_Number)z.x, (lua_Number)z.y, (lua_Number)z.z);
+}
+
+static int basis_tostring(lua_State *L) {
+	push_basis_string(L, check_value<Basis>(L, 1));
+	return 1;
+}
+
+static int transform3d_tostring(lua_State *L) {
+	const Transform3D &t = check_value<Transform3D>(L, 1);
+	push_basis_string(L, t.basis);
+	lua_pushfstring(L, "[%s, O: (%f, %f, %f)]", lua_tostring(L, -1),
+			(lua_Number)t.origin.x, (lua_Number)t.origin.y, (lua_Number)t.origin.z);
+	return 1;
+}
+
+// Methods ---------------------------------------------------------------------
+
+static int vector2_length(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector2>(L, 1).length());
+	return 1;
+}
+
+static int vector2_length_squared(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector2>(L, 1).length_squared());
+	return 1;
+}
+
+static int vector2_normalized(lua_State *L) {
+	push_value(L, check_value<Vector2>(L, 1).normalized());
+	return 1;
+}
+
+static int vector2_dot(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector2>(L, 1).dot(check_value<Vector2>(L, 2)));
+	return 1;
+}
+
+static int vector2_distance_to(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector2>(L, 1).distance_to(check_value<Vector2>(L, 2)));
+	return 1;
+}
+
+static int vector2_lerp(lua_State *L) {
+	push_value(L, check_value<Vector2>(L, 1).lerp(check_value<Vector2>(L, 2), check_real(L, 3)));
+	return 1;
+}
+
+static int vector2_angle(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector2>(L, 1).angle());
+	return 1;
+}
+
+static int vector2_rotated(lua_State *L) {
+	push_value(L, check_value<Vector2>(L, 1).rotated(check_real(L, 2)));
+	return 1;
+}
+
+static const luaL_Reg vector2_methods[] = {
+	{ "length", vector2_length },
+	{ "length_squared", vector2_length_squared },
+	{ "normalized", vector2_normalized },
+	{ "dot", vector2_dot },
+	{ "distance_to", vector2_distance_to },
+	{ "lerp", vector2_lerp },
+	{ "angle", vector2_angle },
+	{ "rotated", vector2_rotated },
+	{ nullptr, nullptr }
+};
+
+static int vector3_length(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector3>(L, 1).length());
+	return 1;
+}
+
+static int vector3_length_squared(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector3>(L, 1).length_squared());
+	return 1;
+}
+
+static int vector3_normalized(lua_State *L) {
+	push_value(L, check_value<Vector3>(L, 1).normalized());
+	return 1;
+}
+
+static int vector3_dot(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector3>(L, 1).dot(check_value<Vector3>(L, 2)));
+	return 1;
+}
+
+static int vector3_cross(lua_State *L) {
+	push_value(L, check_value<Vector3>(L, 1).cross(check_value<Vector3>(L, 2)));
+	return 1;
+}
+
+static int vector3_distance_to(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector3>(L, 1).distance_to(check_value<Vector3>(L, 2)));
+	return 1;
+}
+
+static int vector3_lerp(lua_State *L) {
+	push_value(L, check_value<Vector3>(L, 1).lerp(check_value<Vector3>(L, 2), check_real(L, 3)));
+	return 1;
+}
+
+static const luaL_Reg vector3_methods[] = {
+	{ "length", vector3_length },
+	{ "length_squared", vector3_length_squared },
+	{ "normalized", vector3_normalized },
+	{ "dot", vector3_dot },
+	{ "cross", vector3_cross },
+	{ "distance_to", vector3_distance_to },
+	{ "lerp", vector3_lerp },
+	{ nullptr, nullptr }
+};
+
+static int color_lerp(lua_State *L) {
+	push_value(L, check_value<Color>(L, 1).lerp(check_value<Color>(L, 2), (float)luaL_checknumber(L, 3)));
+	return 1;
+}
+
+static const luaL_Reg color_methods[] = {
+	{ "lerp", color_lerp },
+	{ nullptr, nullptr }
+};
+
+static int rect2_has_point(lua_State *L) {
+	lua_pushboolean(L, check_value<Rect2>(L, 1).has_point(check_value<Vector2>(L, 2)));
+	return 1;
+}
+
+static int rect2_intersects(lua_State *L) {
+	lua_pushboolean(L, check_value<Rect2>(L, 1).intersects(check_value<Rect2>(L, 2)));
+	return 1;
+}
+
+static int rect2_get_center(lua_State *L) {
+	push_value(L, check_value<Rect2>(L, 1).get_center());
+	return 1;
+}
+
+static int rect2_get_area(lua_State *L) {
+	lua_pushnumber(L, check_value<Rect2>(L, 1).get_area());
+	return 1;
+}
+
+static const luaL_Reg rect2_methods[] = {
+	{ "has_point", rect2_has_point },
+	{ "intersects", rect2_intersects },
+	{ "get_center", rect2_get_center },
+	{ "get_area", rect2_get_area },
+	{ nullptr, nullptr }
+};
+
+static int transform2d_inverse(lua_State *L) {
+	push_value(L, check_value<Transform2D>(L, 1).inverse());
+	return 1;
+}
+
+static int transform2d_affine_inverse(lua_State *L) {
+	push_value(L, check_value<Transform2D>(L, 1).affine_inverse());
+	return 1;
+}
+
+static int transform2d_get_rotation(lua_State *L) {
+	lua_pushnumber(L, check_value<Transform2D>(L, 1).get_rotation());
+	return 1;
+}
+
+static int transform2d_xform(lua_State *L) {
+	push_value(L, check_value<Transform2D>(L, 1).xform(check_value<Vector2>(L, 2)));
+	return 1;
+}
+
+static const luaL_Reg transform2d_methods[] = {
+	{ "inverse", transform2d_inverse },
+	{ "affine_inverse", transform2d_affine_inverse },
+	{ "get_rotation", transform2d_get_rotation },
+	{ "xform", transform2d_xform },
+	{ nullptr, nullptr }
+};
+
+static int basis_inverse(lua_State *L) {
+	push_value(L, check_value<Basis>(L, 1).inverse());
+	return 1;
+}
+
+static int basis_transposed(lua_State *L) {
+	push_value(L, check_value<Basis>(L, 1).transposed());
+	return 1;
+}
+
+static int basis_xform(lua_State *L) {
+	push_value(L, check_value<Basis>(L, 1).xform(check_value<Vector3>(L, 2)));
+	return 1;
+}
+
+static const luaL_Reg basis_methods[] = {
+	{ "inverse", basis_inverse },
+	{ "transposed", basis_transposed },
+	{ "xform", basis_xform },
+	{ nullptr, nullptr }
+};
+
+static int transform3d_inverse(lua_State *L) {
+	push_value(L, check_value<Transform3D>(L, 1).inverse());
+	return 1;
+}
+
+static int transform3d_affine_inverse(lua_State *L) {
+	push_value(L, check_value<Transform3D>(L, 1).affine_inverse());
+	return 1;
+}
+
+static int transform3d_xform(lua_State *L) {
+	push_value(L, check_value<Transform3D>(L, 1).xform(check_value<Vector3>(L, 2)));
+	return 1;
+}
+
+static const luaL_Reg transform3d_methods[] = {
+	{ "inverse", transform3d_inverse },
+	{ "affine_inverse", transform3d_affine_inverse },
+	{ "xform", transform3d_xform },
+	{ nullptr, nullptr }
+};
+
+// Constructors ----------------------------------------------------------------
+
+static int vector2_new(lua_State *L) {
+	push_value(L, Vector2((real_t)luaL_optnumber(L, 1, 0), (real_t)luaL_optnumber(L, 2, 0)));
+	return 1;
+}
+
+static int vector3_new(lua_State *L) {
+	push_value(L, Vector3((real_t)luaL_optnumber(L, 1, 0), (real_t)luaL_optnumber(L, 2, 0), (real_t)luaL_optnumber(L, 3, 0)));
+	return 1;
+}
+
+static int color_new(lua_State *L) {
+	Color color;
+	if (lua_type(L, 1) == LUA_TSTRING) {
+		// Color("#ff8800") or Color("ff8800aa")
+		String code = String::utf8(lua_tostring(L, 1));
+		color = Color::html(code);
+	} else {
+		color = Color((float)luaL_checknumber(L, 1), (float)luaL_checknumber(L, 2),
+				(float)luaL_checknumber(L, 3), (float)luaL_optnumber(L, 4, 1.0));
+	}
+	push_value(L, color);
+	return 1;
+}
+
+static int rect2_new(lua_State *L) {
+	if (Vector2 *position = test_value<Vector2>(L, 1)) {
+		push_value(L, Rect2(*position, check_value<Vector2>(L, 2)));
+	} else {
+		push_value(L, Rect2((real_t)luaL_optnumber(L, 1, 0), (real_t)luaL_optnumber(L, 2, 0),
+				(real_t)luaL_optnumber(L, 3, 0), (real_t)luaL_optnumber(L, 4, 0)));
+	}
+	return 1;
+}
+
+static int transform2d_new(lua_State *L) {
+	int argc = lua_gettop(L);
+	if (argc == 0) {
+		push_value(L, Transform2D());
+	} else if (argc == 2) {
+		// Transform2D(rotation, origin)
+		push_value(L, Transform2D(check_real(L, 1), check_value<Vector2>(L, 2)));
+	} else {
+		// Transform2D(x_axis, y_axis, origin)
+		push_value(L, Transform2D(check_value<Vector2>(L, 1), check_value<Vector2>(L, 2), check_value<Vector2>(L, 3)));
+	}
+	return 1;
+}
+
+static int basis_new(lua_State *L) {
+	int argc = lua_gettop(L);
+	if (argc == 0) {
+		push_value(L, Basis());
+	} else if (argc == 2) {
+		// Basis(axis, angle)
+		push_value(L, Basis(check_value<Vector3>(L, 1), check_real(L, 2)));
+	} else {
+		// Basis(x_axis, y_axis, z_axis)
+		push_value(L, Basis(check_value<Vector3>(L, 1), check_value<Vector3>(L, 2), check_value<Vector3>(L, 3)));
+	}
+	return 1;
+}
+
+static int transform3d_new(lua_State *L) {
+	if (lua_gettop(L) == 0) {
+		push_value(L, Transform3D());
+	} else {
+		// Transform3D(basis, origin)
+		push_value(L, Transform3D(check_value<Basis>(L, 1), check_value<Vector3>(L, 2)));
+	}
+	return 1;
+}
+
+// Registration ----------------------------------------------------------------
+
+template <typename T>
+static void register_value_type(lua_State *L, const luaL_Reg *methods, lua_CFunction constructor, lua_CFunction tostring) {
+	luaL_newmetatable(L, ValueType<T>::name);
+
+	// getmetatable() returns the name instead, so scripts cannot edit the shared metatable
+	lua_pushstring(L, ValueType<T>::name);
+	lua_setfield(L, -2, "__metatable");
+
+	// __index: fields first, then the methods table bound as upvalue
+	lua_newtable(L);
+	luaL_setfuncs(L, methods, 0);
+	lua_pushcclosure(L, value_index<T>, 1);
+	lua_setfield(L, -2, "__index");
+
+	lua_pushcfunction(L, value_newindex<T>);
+	lua_setfield(L, -2, "__newindex");
+	lua_pushcfunction(L, value_eq<T>);
+	lua_setfield(L, -2, "__eq");
+	lua_pushcfunction(L, tostring);
+	lua_setfield(L, -2, "__tostring");
+
+	lua_pushcfunction(L, constructor);
+	lua_setglobal(L, ValueType<T>::name);
+}
+
+void godot::lua_register_value_types(lua_State *L) {
+	register_value_type<Vector2>(L, vector2_methods, vector2_new, vector2_tostring);
+	lua_pushcfunction(L, value_add<Vector2>);
+	lua_setfield(L, -2, "__add");
+	lua_pushcfunction(L, value_sub<Vector2>);
+	lua_setfield(L, -2, "__sub");
+	lua_pushcfunction(L, value_mul<Vector2>);
+	lua_setfield(L, -2, "__mul");
+	lua_pushcfunction(L, value_div<Vector2>);
+	lua_setfield(L, -2, "__div");
+	lua_pushcfunction(L, value_unm<Vector2>);
+	lua_setfield(L, -2, "__unm");
+	lua_pop(L, 1);
+
+	register_value_type<Vector3>(L, vector3_methods, vector3_new, vector3_tostring);
+	lua_pushcfunction(L, value_add<Vector3>);
+	lua_setfield(L, -2, "__add");
+	lua_pushcfunction(L, value_sub<Vector3>);
+	lua_setfield(L, -2, "__sub");
+	lua_pushcfunction(L, value_mul<Vector3>);
+	lua_setfield(L, -2, "__mul");
+	lua_pushcfunction(L, value_div<Vector3>);
+	lua_setfield(L, -2, "__div");
+	lua_pushcfunction(L, value_unm<Vector3>);
+	lua_setfield(L, -2, "__unm");
+	lua_pop(L, 1);
+
+	register_value_type<Color>(L, color_methods, color_new, color_tostring);
+	lua_pushcfunction(L, value_add<Color>);
+	lua_setfield(L, -2, "__add");
+	lua_pushcfunction(L, value_sub<Color>);
+	lua_setfield(L, -2, "__sub");
+	lua_pushcfunction(L, value_mul<Color>);
+	lua_setfield(L, -2, "__mul");
+	lua_pushcfunction(L, value_div<Color>);
+	lua_setfield(L, -2, "__div");
+	lua_pop(L, 1);
+
+	register_value_type<Rect2>(L, rect2_methods, rect2_new, rect2_tostring);
+	lua_pop(L, 1);
+
+	register_value_type<Transform2D>(L, transform2d_methods, transform2d_new, transform2d_tostring);
+	lua_pushcfunction(L, (transform_mul<Transform2D, Vector2>));
+	lua_setfield(L, -2, "__mul");
+	lua_pop(L, 1);
+
+	register_value_type<Basis>(L, basis_methods, basis_new, basis_tostring);
+	lua_pushcfunction(L, (transform_mul<Basis, Vector3>));
+	lua_setfield(L, -2, "__mul");
+	lua_pop(L, 1);
+
+	register_value_type<Transform3D>(L, transform3d_methods, transform3d_new, transform3d_tostring);
+	lua_pushcfunction(L, (transform_mul<Transform3D, Vector3>));
+	lua_setfield(L, -2, "__mul");
+	lua_pop(L, 1);
+}
+
+bool godot::lua_push_value_type(lua_State *L, const Variant &value) {
+	switch (value.get_type()) {
+		case Variant::VECTOR2:
+			push_value(L, (Vector2)value);
+			return true;
+		case Variant::VECTOR3:
+			push_value(L, (Vector3)value);
+			return true;
+		case Variant::COLOR:
+			push_value(L, (Color)value);
+			return true;
+		case Variant::RECT2:
+			push_value(L, (Rect2)value);
+			return true;
+		case Variant::TRANSFORM2D:
+			push_value(L, (Transform2D)value);
+			return true;
+		case Variant::BASIS:
+			push_value(L, (Basis)value);
+			return true;
+		case Variant::TRANSFORM3D:
+			push_value(L, (Transform3D)value);
+			return true;
+		default:
+			return false;
+	}
+}
+
+// The type is found by metatable identity, never from a field scripts could rewrite
+template <typename T>
+static bool to_variant(lua_State *L, int index, Variant &r_value) {
+	T *value = test_value<T>(L, index);
+	if (!value) {
+		return false;
+	}
+	r_value = *value;
+	return true;
+}
+
+bool godot::lua_to_value_type(lua_State *L, int index, Variant &r_value) {
+	if (lua_type(L, index) != LUA_TUSERDATA) {
+		return false;
+	}
+	return to_variant<Vector2>(L, index, r_value) ||
+			to_variant<Vector3>(L, index, r_value) ||
+			to_variant<Color>(L, index, r_value) ||
+			to_variant<Rect2>(L, index, r_value) ||
+			to_variant<Transform2D>(L, index, r_value) ||
+			to_variant<Basis>(L, index, r_value) ||
+			to_variant<Transform3D>(L, index, r_value);
+}
+
+template <typename T>
+void godot::lua_push_value(lua_State *L, const T &value) {
+	push_value(L, value);
+}
+
+template <typename T>
+T *godot::lua_test_value(lua_State *L, int index) {
+	return test_value<T>(L, index);
+}
+
+#define LUA_VALUE_TYPE_INSTANTIATE(m_type)                                   \
+	template void godot::lua_push_value<m_type>(lua_State *, const m_type &); \
+	template m_type *godot::lua_test_value<m_type>(lua_State *, int);
+
+LUA_VALUE_TYPE_INSTANTIATE(Vector2)
+LUA_VALUE_TYPE_INSTANTIATE(Vector3)
+LUA_VALUE_TYPE_INSTANTIATE(Color)
+LUA_VALUE_TYPE_INSTANTIATE(Rect2)
+LUA_VALUE_TYPE_INSTANTIATE(Transform2D)
+LUA_VALUE_TYPE_INSTANTIATE(Basis)
+LUA_VALUE_TYPE_INSTANTIATE(Transform3D)
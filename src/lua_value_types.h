@@ -0,0 +1,50 @@
+#ifndef LUA_VALUE_TYPES_H
+#define LUA_VALUE_TYPES_H
+
+#include <godot_cpp/variant/variant.hpp>
+
+// Forward declarations
+struct lua_State;
+
+namespace godot {
+
+// Vector2, Vector3, Color, Rect2, Transform2D, Basis and Transform3D are stored
+// by value in full userdata with arithmetic and field-access metamethods, so
+// they cross the bridge without any Dictionary or table allocation.
+
+/**
+ * Registers the value type metatables and their constructor globals
+ * (Vector2(x, y), Vector3(x, y, z), Color(r, g, b[, a]), Rect2(...),
+ * Transform2D(...), Basis(...), Transform3D(...)).
+ */
+void lua_register_value_types(lua_State *L);
+
+/**
+ * Pushes a value type Variant as userdata.
+ * @return False (and nothing pushed) if the Variant is not a supported value type.
+ */
+bool lua_push_value_type(lua_State *L, const Variant &value);
+
+/**
+ * Reads a value type userdata at the given stack index.
+ * @return False if the value is not a value type userdata.
+ */
+bool lua_to_value_type(lua_State *L, int index, Variant &r_value);
+
+/**
+ * Pushes a value type directly, without a Variant round trip.
+ * Defined for Vector2, Vector3, Color, Rect2, Transform2D, Basis and Transform3D.
+ */
+template <typename T>
+void lua_push_value(lua_State *L, const T &value);
+
+/**
+ * Returns the value stored in the userdata at the given stack index.
+ * @return Null if the value is not a T.
+ */
+template <typename T>
+T *lua_test_value(lua_State *L, int index);
+
+} // namespace godot
+
+#endif // LUA_VALUE_TYPES_H
@@ -2,6 +2,8 @@
 #include "mod_resource_loader.h"
 
 #include "bridge.h"
+#include "lua_log.h"
+#include "lua_table.h"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/class_db.hpp>
@@ -19,13 +21,16 @@ void initialize_lua_bridge_module(ModuleInitializationLevel p_level) {
 	}
 
 	ClassDB::register_class<LuaBridge>();
-	ClassDB::register_class<LuaSignalRelay>();
+	ClassDB::register_class<LuaTable>();
 }
 
 void uninitialize_lua_bridge_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+
+	// The log ring is process-wide and outlives every bridge: write out what is left and free it
+	LuaLog::set_buffered(false, 0);
 }
 
 void initialize_lua_godot_module(ModuleInitializationLevel p_level) {
@@ -50,6 +55,8 @@ void uninitialize_lua_godot_module(ModuleInitializationLevel p_level) {
 		ResourceLoader::get_singleton()->remove_resource_format_loader(mod_loader);
 		mod_loader.unref();
 	}
+
+	uninitialize_lua_bridge_module(p_level);
 }
 
 extern "C" {
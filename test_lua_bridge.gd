@@ -40,6 +40,63 @@ func _ready():
     
     # Test autoload singleton access
     test_autoload_singleton()
+    
+    # Test math value types in Lua
+    test_value_types()
+    
+    # Test packed array views
+    test_packed_arrays()
+    
+    # Test Lua table to Array/Dictionary conversion
+    test_table_conversion()
+    
+    # Test Array/Dictionary to Lua table conversion
+    test_container_push()
+    
+    # Test shared sub-tables, cycles and conversion limits
+    test_table_limits()
+    
+    # Test Dictionary/Array proxies in Lua
+    test_container_proxies()
+    
+    # Test functions bound with bind_native
+    test_native_bindings()
+    
+    # Test argument marshalling of registered functions
+    test_registered_function_arguments()
+    
+    # Test calling Godot methods from Lua
+    test_bound_methods()
+    
+    # Test Lua functions as Godot Callables
+    test_lua_callables()
+    
+    # Test lazy LuaTable proxies
+    test_lua_tables()
+    
+    # Test buffered logging
+    test_log_buffering()
+    
+    # Test the pooled Lua allocator
+    test_memory_pool()
+    
+    # Test per-mod memory accounting
+    test_mod_memory_budget()
+    
+    # Test frame-budgeted garbage collection
+    test_frame_gc()
+    
+    # Test the compiled chunk cache
+    test_bytecode_cache()
+    
+    # Test BOM and shebang handling in the script loader
+    test_script_loading()
+    
+    # Test require() resolution and caching
+    test_require_cache()
+    
+    # Test pre-resolved function handles across mod reloads
+    test_function_handles()
 
 func test_basic_operations():
     #print("\n=== Testing Basic Operations ===")
@@ -312,6 +369,593 @@ func test_autoload_singleton():
         else:
             #print("✗ No singleton found: ", name)
 
+func test_value_types():
+    #print("\n=== Testing Value Types ===")
+    
+    var bridge = LuaBridge.new()
+    
+    # Math types cross as native userdata with fields, methods and operators
+    bridge.set_global("v", Vector2(3, 4))
+    bridge.exec_string("len = v:length(); x = v.x; sum = v + Vector2(1, 1); scaled = 2 * Vector3(1, 2, 3)")
+    assert(is_equal_approx(bridge.get_global("len"), 5.0))
+    assert(bridge.get_global("x") == 3)
+    assert(bridge.get_global("sum") == Vector2(4, 5))
+    assert(bridge.get_global("scaled") == Vector3(2, 4, 6))
+    
+    # They compare by value and keep Godot's copy semantics
+    bridge.exec_string("same = Vector2(1, 2) == Vector2(1, 2); ok = pcall(function() v.x = 10 end)")
+    assert(bridge.get_global("same") == true)
+    assert(bridge.get_global("ok") == false)
+    
+    bridge.exec_string("c = Color(1, 0, 0, 1); t = Transform2D()")
+    assert(bridge.get_global("c") == Color(1, 0, 0, 1))
+    assert(bridge.get_global("t") == Transform2D())
+
+    # The metatables are hidden, so scripts cannot change how a value converts
+    bridge.exec_string("mt = getmetatable(Vector2()); ok = pcall(function() getmetatable(Vector2()).__index = nil end)")
+    assert(bridge.get_global("mt") == "Vector2")
+    assert(bridge.get_global("ok") == false)
+    assert(bridge.get_global("v") == Vector2(3, 4))
+
+    bridge.unload()
+
+func test_packed_arrays():
+    #print("\n=== Testing Packed Arrays ===")
+    
+    var bridge = LuaBridge.new()
+    
+    # A view shares the buffer until Lua writes, then the GDScript copy is untouched
+    var bytes = PackedByteArray([1, 2, 3])
+    bridge.set_global("bytes", bytes)
+    bridge.exec_string("first = bytes[1]; bytes[1] = 9; bytes[#bytes + 1] = 4")
+    assert(bridge.get_global("first") == 1)
+    assert(bytes == PackedByteArray([1, 2, 3]))
+    assert(bridge.get_global("bytes") == PackedByteArray([9, 2, 3, 4]))
+    
+    # Values outside the element range are rejected instead of truncated
+    bridge.exec_string("ok_set = pcall(function() bytes[1] = 300 end); ok_new = pcall(PackedByteArray, {1, -1})")
+    assert(bridge.get_global("ok_set") == false)
+    assert(bridge.get_global("ok_new") == false)
+    assert(bridge.get_global("bytes") == PackedByteArray([9, 2, 3, 4]))
+    bridge.exec_string("ok_int = pcall(function() local a = PackedInt32Array(1); a[1] = 2^40 // 1 end)")
+    assert(bridge.get_global("ok_int") == false)
+    
+    # A hidden metatable keeps scripts from changing how a view converts
+    bridge.exec_string("mt = getmetatable(PackedFloat32Array())")
+    assert(bridge.get_global("mt") == "PackedFloat32Array")
+    
+    bridge.unload()
+
+func test_table_conversion():
+    #print("\n=== Testing Table Conversion ===")
+    
+    var bridge = LuaBridge.new()
+    
+    # A sequence becomes an Array, anything with other keys a Dictionary
+    bridge.exec_string("seq = {10, 20, 30}; mixed = {10, 20, name = 'x'}; hash_first = {name = 'y'}; empty = {}")
+    var seq = bridge.get_global("seq")
+    assert(seq is Array and seq == [10, 20, 30])
+    var mixed = bridge.get_global("mixed")
+    assert(mixed is Dictionary and mixed == {1: 10, 2: 20, "name": "x"})
+    assert(bridge.get_global("hash_first") == {"name": "y"})
+    assert(bridge.get_global("empty") is Dictionary)
+    
+    # The migration to a Dictionary happens wherever the first non-sequence key shows up
+    bridge.exec_string("late = {1, 2, 3}; late.extra = true; nested = {list = {4, 5}, [1] = {k = 'v'}}")
+    assert(bridge.get_global("late") == {1: 1, 2: 2, 3: 3, "extra": true})
+    var nested = bridge.get_global("nested")
+    assert(nested["list"] == [4, 5])
+    assert(nested[1] == {"k": "v"})
+    
+    bridge.unload()
+
+func test_container_push():
+    #print("\n=== Testing Container Push ===")
+    
+    var bridge = LuaBridge.new()
+    
+    # Arrays become 1-based sequences and Dictionaries keep their keys, nested ones included
+    var data = {"list": [1, 2, [3, 4]], "name": "n", 5: "five"}
+    bridge.set_global("data", data)
+    bridge.exec_string("list_len = #data.list; inner = data.list[3][2]; name = data.name; five = data[5]")
+    assert(bridge.get_global("list_len") == 3)
+    assert(bridge.get_global("inner") == 4)
+    assert(bridge.get_global("name") == "n")
+    assert(bridge.get_global("five") == "five")
+    
+    # Without container proxies Lua gets its own tables
+    bridge.exec_string("data.name = 'changed'")
+    assert(data["name"] == "n")
+    
+    # Deep nesting grows the Lua stack as needed
+    var deep = []
+    var current = deep
+    for i in range(100):
+        var next_level = []
+        current.append(next_level)
+        current = next_level
+    current.append("bottom")
+    bridge.set_global("deep", deep)
+    bridge.exec_string("local t = deep; for i = 1, 100 do t = t[1] end; bottom = t[1]")
+    assert(bridge.get_global("bottom") == "bottom")
+    
+    bridge.unload()
+
+func test_table_limits():
+    #print("\n=== Testing Table Limits ===")
+    
+    var bridge = LuaBridge.new()
+    
+    # A sub-table reached twice converts once and stays shared
+    bridge.exec_string("shared = {1, 2}; s = {a = shared, b = shared}")
+    var s = bridge.get_global("s")
+    assert(s["a"] == [1, 2])
+    assert(is_same(s["a"], s["b"]))
+    
+    # A reference cycle fails the conversion instead of recursing forever
+    bridge.exec_string("cycle = {}; cycle.next = {back = cycle}")
+    assert(bridge.get_global("cycle") == null)
+    
+    # Nesting deeper than the limit fails the whole conversion
+    bridge.set_conversion_max_depth(3)
+    bridge.exec_string("three = {{{1}}}; four = {{{{1}}}}")
+    assert(bridge.get_global("three") == [[[1]]])
+    assert(bridge.get_global("four") == null)
+    
+    # The element budget covers every nested table of one conversion
+    bridge.set_conversion_max_elements(5)
+    bridge.exec_string("five = {1, 2, 3, 4, 5}; six = {1, 2, 3, 4, 5, 6}; split = {{1, 2, 3}, {4, 5, 6}}")
+    assert(bridge.get_global("five") == [1, 2, 3, 4, 5])
+    assert(bridge.get_global("six") == null)
+    assert(bridge.get_global("split") == null)
+    bridge.set_conversion_max_elements(0)
+    assert(bridge.get_global("split") == [[1, 2, 3], [4, 5, 6]])
+    
+    bridge.unload()
+
+func test_container_proxies():
+    #print("\n=== Testing Container Proxies ===")
+    
+    var bridge = LuaBridge.new()
+    bridge.set_container_proxies_enabled(true)
+    var inventory = {"gold": 5, "items": ["sword"]}
+    bridge.set_global("inv", inventory)
+    
+    # __newindex writes through to the shared containers, nested ones included
+    bridge.exec_string("inv.gold = inv.gold + 10; inv.items[#inv.items + 1] = 'shield'; inv.items[1] = 'axe'")
+    assert(inventory["gold"] == 15)
+    assert(inventory["items"] == ["axe", "shield"])
+    bridge.exec_string("ok = pcall(function() inv.items[5] = 'gap' end)")
+    assert(bridge.get_global("ok") == false)
+    
+    # __pairs walks the live container
+    bridge.exec_string("keys = 0; for k, v in pairs(inv) do keys = keys + 1 end; joined = ''; for i, v in pairs(inv.items) do joined = joined .. i .. v end")
+    assert(bridge.get_global("keys") == 2)
+    assert(bridge.get_global("joined") == "1axe2shield")
+    
+    # Assigning nil erases the key, and the proxy comes back as the same Dictionary
+    bridge.exec_string("inv.gold = nil")
+    assert(not inventory.has("gold"))
+    assert(is_same(bridge.get_global("inv"), inventory))
+    
+    bridge.unload()
+
+func test_native_bindings():
+    #print("\n=== Testing Native Bindings ===")
+    
+    # get_instance_id is bound through bind_native with an Object* argument
+    var bridge = LuaBridge.new()
+    var node = Node.new()
+    bridge.set_global("probe", node)
+    bridge.exec_string("probe_id = get_instance_id(probe); nil_id = get_instance_id(nil)")
+    assert(bridge.get_global("probe_id") == node.get_instance_id())
+    assert(bridge.get_global("nil_id") == 0)
+    
+    # A value that is not a Godot object is rejected with a Lua error
+    bridge.exec_string("ok = pcall(get_instance_id, 42)")
+    assert(bridge.get_global("ok") == false)
+    
+    node.free()
+    bridge.unload()
+
+func _sum17(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17):
+    return a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10 + a11 + a12 + a13 + a14 + a15 + a16 + a17
+
+func test_registered_function_arguments():
+    #print("\n=== Testing Registered Function Arguments ===")
+    
+    var bridge = LuaBridge.new()
+    
+    # Calls with more than 16 arguments still convert every argument and report call errors
+    bridge.register_function("sum17", _sum17)
+    bridge.exec_string("total = sum17(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17)")
+    assert(bridge.get_global("total") == 153)
+    bridge.exec_string("ok = pcall(sum17, 1, 2)")
+    assert(bridge.get_global("ok") == false)
+    
+    # Typed signatures are limited to 16 arguments and longer ones are not registered
+    var arg_types = PackedInt32Array()
+    arg_types.resize(17)
+    arg_types.fill(TYPE_INT)
+    bridge.register_function_with_signature("typed17", _sum17, arg_types)
+    assert(bridge.get_global("typed17") == null)
+    
+    bridge.unload()
+
+func test_bound_methods():
+    #print("\n=== Testing Bound Methods ===")
+    
+    var bridge = LuaBridge.new()
+    var node = Node.new()
+    bridge.set_global("node", node)
+    
+    bridge.exec_string("node:set_name('FromLua'); node_name = node:get_name()")
+    assert(node.name == "FromLua")
+    assert(bridge.get_global("node_name") == "FromLua")
+    
+    # Arguments past the declared ones are rejected, except by vararg methods
+    bridge.exec_string("ok = pcall(function() node:set_name('a', 'b') end)")
+    assert(bridge.get_global("ok") == false)
+    bridge.exec_string("node:call('set_name', 'ViaCall')")
+    assert(node.name == "ViaCall")
+
+    # A script attached after the object was wrapped brings its methods along,
+    # even one whose lookup already missed
+    bridge.exec_string("before = node.greet")
+    assert(bridge.get_global("before") == null)
+    var script = GDScript.new()
+    script.source_code = "extends Node\n\nfunc greet(who):\n\treturn 'hi ' + who\n"
+    script.reload()
+    node.set_script(script)
+    bridge.exec_string("greeting = node:greet('lua')")
+    assert(bridge.get_global("greeting") == "hi lua")
+
+    node.free()
+    bridge.unload()
+
+func test_lua_callables():
+    #print("\n=== Testing Lua Callables ===")
+    
+    var bridge = LuaBridge.new()
+    bridge.exec_string("function double(x) return x * 2 end; hits = 0; function on_poked(a, b) hits = hits + a + b end")
+    
+    # Lua functions come back as Callables that call the function directly
+    var double = bridge.get_global("double")
+    assert(double is Callable and double.is_valid())
+    assert(double.call(21) == 42)
+    
+    # Passed back to Lua, the Callable is the original function again
+    bridge.set_global("double_again", double)
+    bridge.exec_string("same = double_again == double")
+    assert(bridge.get_global("same") == true)
+    
+    # Signals connect to the function itself and forward every argument
+    var emitter = Node.new()
+    emitter.add_user_signal("poked")
+    assert(bridge.connect_signal(emitter, "poked", "on_poked"))
+    emitter.emit_signal("poked", 2, 3)
+    assert(bridge.get_global("hits") == 5)
+    
+    # Once the Lua state is gone the Callable is invalid rather than dangling
+    bridge.unload()
+    assert(not double.is_valid())
+    emitter.free()
+
+func test_lua_tables():
+    #print("\n=== Testing Lua Tables ===")
+    
+    var bridge = LuaBridge.new()
+    bridge.set_table_proxies_enabled(true)
+    bridge.exec_string("config = { name = 'demo', items = { 10, 20, 30 }, nested = { depth = 2 } }")
+    
+    # Tables come back as proxies; nested tables are proxies too and nothing is copied up front
+    var config = bridge.get_global("config")
+    assert(config is LuaTable)
+    assert(config.get_value("name") == "demo")
+    var items = config.get_value("items")
+    assert(items is LuaTable and items.size() == 3)
+    assert(items.get_value(2) == 20)
+    assert(config.nested.get_value("depth") == 2)
+    
+    # Writes go straight to the Lua table, and null removes the field
+    config.set_value("name", "changed")
+    bridge.exec_string("seen = config.name")
+    assert(bridge.get_global("seen") == "changed")
+    config.set_value("name", null)
+    assert(not config.has("name"))
+    
+    # Existing fields can be written as properties; Object properties are left to Object
+    config.nested.depth = 3
+    assert(config.nested.get_value("depth") == 3)
+    config.set_meta("tag", 7)
+    assert(config.get_meta("tag") == 7)
+    assert(not config.has("metadata/tag"))
+    
+    var keys = []
+    for key in config:
+        keys.append(key)
+    assert(keys.size() == 2 and keys.has("items") and keys.has("nested"))
+    assert(items.to_dictionary() == {1: 10, 2: 20, 3: 30})
+    
+    # A proxy outliving its Lua state reports itself invalid instead of crashing
+    bridge.unload()
+    assert(not config.is_valid())
+    assert(config.get_value("items") == null)
+
+func test_log_buffering():
+    #print("\n=== Testing Log Buffering ===")
+    
+    var bridge = LuaBridge.new()
+    bridge.set_log_buffer_capacity(4)
+    bridge.set_log_buffering(true)
+    assert(bridge.is_log_buffering())
+    
+    # Lua print is queued until flushed; a full ring drops and counts instead of blocking
+    bridge.exec_string("for i = 1, 10 do print('buffered', i) end")
+    assert(bridge.get_dropped_log_count() > 0)
+    assert(bridge.flush_logs() == 4)
+    assert(bridge.flush_logs() == 0)
+    
+    # Turning buffering off frees the ring
+    bridge.set_log_buffering(false)
+    assert(not bridge.is_log_buffering())
+    assert(bridge.get_dropped_log_count() == 0)
+    
+    # Level and categories belong to each bridge
+    var other = LuaBridge.new()
+    bridge.set_verbose_logging(true)
+    bridge.set_log_categories(LuaBridge.LOG_MODS)
+    assert(bridge.is_verbose_logging())
+    assert(not other.is_verbose_logging())
+    assert(other.get_log_categories() != bridge.get_log_categories())
+    other.unload()
+    bridge.unload()
+
+func test_memory_pool():
+    #print("\n=== Testing Memory Pool ===")
+    
+    var bridge = LuaBridge.new()
+    var before = bridge.get_memory_stats()
+    assert(before["size_classes"].size() == 12)
+    
+    # Small strings are served from the pooled size classes, large ones from the system allocator
+    bridge.exec_string("small = {}; for i = 1, 1000 do small[i] = 'v' .. i end; big = ('x'):rep(100000)")
+    var after = bridge.get_memory_stats()
+    assert(after["bytes_in_use"] > before["bytes_in_use"] + 100000)
+    assert(after["large_allocations"] > before["large_allocations"])
+    var pooled = 0
+    for size_class in after["size_classes"]:
+        pooled += size_class["blocks_in_use"]
+    assert(pooled > 1000)
+    assert(after["peak_bytes"] >= after["bytes_in_use"])
+    
+    # Everything freed by the collector comes back off the books
+    bridge.exec_string("small = nil; big = nil; collectgarbage()")
+    assert(bridge.get_memory_stats()["bytes_in_use"] < after["bytes_in_use"] - 100000)
+    
+    # warn() reaches the bridge log instead of being dropped, and its control messages are honored
+    bridge.exec_string("warn('from test'); warn('@off'); warn('muted'); warn('@on')")
+    
+    bridge.unload()
+    assert(bridge.get_memory_stats().is_empty())
+
+func test_frame_gc():
+    #print("\n=== Testing Frame GC ===")
+    
+    var bridge = LuaBridge.new()
+    bridge.exec_string("function on_update(delta) end")
+    
+    # With a frame budget the collector no longer runs on its own, so garbage piles up
+    bridge.set_gc_frame_budget(2000)
+    assert(bridge.get_gc_frame_budget() == 2000)
+    bridge.exec_string("for i = 1, 50000 do local t = { i } end")
+    var piled_up_kb = bridge.get_gc_stats()["memory_kb"]
+    assert(bridge.get_gc_stats()["cycles_completed"] == 0)
+    
+    # ...until call_on_update steps it within the budget, a slice per frame
+    for i in range(200):
+        bridge.call_on_update(0.016)
+    var stats = bridge.get_gc_stats()
+    assert(stats["cycles_completed"] > 0)
+    assert(stats["memory_kb"] < piled_up_kb)
+    assert(stats["total_usec"] > 0)
+    
+    # Generational mode completes a minor collection per step
+    bridge.set_gc_mode(LuaBridge.GC_GENERATIONAL)
+    assert(bridge.get_gc_mode() == LuaBridge.GC_GENERATIONAL)
+    var cycles = bridge.get_gc_stats()["cycles_completed"]
+    bridge.exec_string("for i = 1, 50000 do local t = { i } end")
+    bridge.call_on_update(0.016)
+    assert(bridge.get_gc_stats()["cycles_completed"] == cycles + 1)
+    
+    # Adaptive tuning keeps its settings within Lua's accepted ranges
+    bridge.set_gc_adaptive(true)
+    bridge.set_gc_target_frame_fraction(0.02)
+    for i in range(60):
+        bridge.call_on_update(0.016)
+    stats = bridge.get_gc_stats()
+    assert(stats["adaptive"] and stats["pause"] > 100)
+    
+    # Dropping the budget hands collection back to Lua
+    bridge.set_gc_adaptive(false)
+    bridge.set_gc_frame_budget(0)
+    bridge.exec_string("collectgarbage('step')")
+    bridge.unload()
+
+func _write_test_file(path, text):
+    DirAccess.make_dir_recursive_absolute(path.get_base_dir())
+    var file = FileAccess.open(path, FileAccess.WRITE)
+    file.store_string(text)
+    file.close()
+
+func test_mod_memory_budget():
+    #print("\n=== Testing Mod Memory Budget ===")
+    
+    var mod_dir = "user://test_mods/budget_mod"
+    _write_test_file(mod_dir + "/mod.json", JSON.stringify({"name": "BudgetMod", "entry_script": "main.lua", "memory_limit": 65536}))
+    _write_test_file(mod_dir + "/main.lua", """
+hoard = {}
+for i = 1, 10000 do hoard[i] = ('x'):rep(64) .. i end
+
+function grow()
+    local t = {}
+    for i = 1, 10000 do t[i] = ('y'):rep(64) .. i end
+    return #t
+end
+""")
+    
+    var bridge = LuaBridge.new()
+    var events = []
+    bridge.mod_over_budget.connect(func(mod_name, bytes_in_use, memory_limit): events.append(mod_name))
+    
+    # Limits only report by default: the entry script runs to completion past its budget
+    assert(not bridge.is_memory_limits_enforced())
+    assert(bridge.load_mod_from_json(mod_dir + "/mod.json"))
+    assert(bridge.get_mod_memory_usage("BudgetMod") > 65536)
+    assert(events == ["BudgetMod"])
+    assert(bridge.get_mod_info("BudgetMod")["memory_limit"] == 65536)
+    
+    # Memory freed by the collector is credited back to the mod that allocated it
+    bridge.exec_string("hoard = nil; collectgarbage()")
+    assert(bridge.get_mod_memory_usage("BudgetMod") < 65536)
+    
+    # Enforced limits fail the allocation in the mod's own code
+    bridge.set_memory_limits_enforced(true)
+    assert(bridge.call_function("grow", []) == null)
+    assert(bridge.get_mod_memory_usage("BudgetMod") <= 65536)
+    
+    var stats = bridge.get_memory_stats()
+    assert(stats["bytes_in_use"] > 0)
+    bridge.unload()
+
+func test_bytecode_cache():
+    #print("\n=== Testing Bytecode Cache ===")
+    
+    var script_path = "user://test_scripts/cached.lua"
+    var bridge = LuaBridge.new()
+    bridge.clear_bytecode_cache()
+    
+    # The first load compiles and stores the chunk, the second reads it back
+    _write_test_file(script_path, "cached_value = 1")
+    assert(bridge.load_file(script_path))
+    assert(bridge.load_file(script_path))
+    var stats = bridge.get_bytecode_cache_stats()
+    assert(stats["misses"] == 1 and stats["hits"] == 1)
+    
+    # Editing the script changes its key, so the stale entry is never read
+    _write_test_file(script_path, "cached_value = 2")
+    assert(bridge.load_file(script_path))
+    assert(bridge.get_global("cached_value") == 2)
+    assert(bridge.get_bytecode_cache_stats()["misses"] == 2)
+    
+    # A truncated entry is discarded and rebuilt from source
+    var cache_dir = stats["cache_dir"]
+    for file_name in DirAccess.get_files_at(cache_dir):
+        _write_test_file(cache_dir.path_join(file_name), "\u001bLua")
+    assert(bridge.load_file(script_path))
+    assert(bridge.get_global("cached_value") == 2)
+    assert(bridge.load_file(script_path))
+    assert(bridge.get_bytecode_cache_stats()["hits"] == 2)
+    
+    bridge.unload()
+
+func test_script_loading():
+    #print("\n=== Testing Script Loading ===")
+    
+    var bridge = LuaBridge.new()
+    
+    # A UTF-8 BOM and a first line starting with '#' are skipped, as by luaL_loadfile
+    _write_test_file("user://test_scripts/bom.lua", "\uFEFFbom_loaded = true\n")
+    _write_test_file("user://test_scripts/shebang.lua", "#!/usr/bin/env lua\nshebang_loaded = true\nfunction fail_here() error('here') end\n")
+    _write_test_file("user://test_scripts/bom_shebang.lua", "\uFEFF#!lua\nbom_shebang_loaded = true\n")
+    for script in ["bom", "shebang", "bom_shebang"]:
+        # Twice, so the cached chunk is exercised as well
+        assert(bridge.load_file("user://test_scripts/" + script + ".lua"))
+        assert(bridge.load_file("user://test_scripts/" + script + ".lua"))
+    assert(bridge.get_global("bom_loaded") == true)
+    assert(bridge.get_global("shebang_loaded") == true)
+    assert(bridge.get_global("bom_shebang_loaded") == true)
+    
+    # The skipped line still counts, so errors report the line in the file
+    bridge.exec_string("local ok, err = pcall(fail_here); fail_line = err:match(':(%d+):')")
+    assert(bridge.get_global("fail_line") == "3")
+    
+    # A '#' anywhere else is still a syntax error
+    _write_test_file("user://test_scripts/late_hash.lua", "x = 1\n#!not a comment\n")
+    assert(not bridge.load_file("user://test_scripts/late_hash.lua"))
+    
+    bridge.unload()
+
+func test_require_cache():
+    #print("\n=== Testing Require Cache ===")
+    
+    var mod_dir = "user://test_mods/require_mod"
+    _write_test_file(mod_dir + "/mod.json", JSON.stringify({"name": "RequireMod", "entry_script": "main.lua"}))
+    _write_test_file(mod_dir + "/counter.lua", "local M = { value = 0 }\nfunction M.bump() M.value = M.value + 1 end\nreturn M\n")
+    _write_test_file(mod_dir + "/util/init.lua", "return { name = 'util' }\n")
+    _write_test_file(mod_dir + "/loop_a.lua", "require('loop_b')\nreturn {}\n")
+    _write_test_file(mod_dir + "/loop_b.lua", "require('loop_a')\nreturn {}\n")
+    # Found through the shared mods/<name>.lua fallback, outside the mod's directory
+    var shared_path = "mods/require_test_shared.lua"
+    _write_test_file(shared_path, "shared_loads = (shared_loads or 0) + 1\nreturn {}\n")
+    _write_test_file(mod_dir + "/main.lua", """
+local counter = require('counter')
+counter.bump()
+local again = require('counter')
+same_module = counter == again
+count = again.value
+util_name = require('util').name
+local ok, err = pcall(require, 'loop_a')
+loop_detected = not ok and err:find('Loop', 1, true) ~= nil
+missing_failed = not pcall(require, 'missing')
+require('require_test_shared')
+""")
+    
+    var bridge = LuaBridge.new()
+    assert(bridge.load_mod_from_json(mod_dir + "/mod.json"))
+    
+    # A module runs once and every require returns the same value
+    assert(bridge.get_global("same_module") == true)
+    assert(bridge.get_global("count") == 1)
+    # name/init.lua is found next to the mod's scripts
+    assert(bridge.get_global("util_name") == "util")
+    # Cycles and missing modules raise errors, even through pcall(require, ...)
+    assert(bridge.get_global("loop_detected") == true)
+    assert(bridge.get_global("missing_failed") == true)
+    assert(bridge.get_global("shared_loads") == 1)
+    
+    # Reloading the mod runs its modules again instead of reusing the cached ones,
+    # including the ones it found through the fallback
+    assert(bridge.reload_mod("RequireMod"))
+    assert(bridge.get_global("count") == 1)
+    assert(bridge.get_global("shared_loads") == 2)
+    
+    bridge.unload()
+    DirAccess.remove_absolute(shared_path)
+
+func test_function_handles():
+    #print("\n=== Testing Function Handles ===")
+    
+    for mod in ["handle_a", "handle_b"]:
+        var mod_dir = "user://test_mods/" + mod
+        _write_test_file(mod_dir + "/mod.json", JSON.stringify({"name": mod, "entry_script": "main.lua"}))
+        _write_test_file(mod_dir + "/main.lua", "function " + mod + "_value() return '" + mod + "' end\n")
+    
+    var bridge = LuaBridge.new()
+    assert(bridge.load_mod_from_json("user://test_mods/handle_a/mod.json"))
+    assert(bridge.load_mod_from_json("user://test_mods/handle_b/mod.json"))
+    var handle_a = bridge.resolve_function("handle_a_value")
+    var handle_b = bridge.resolve_function("handle_b_value")
+    assert(bridge.call_handle(handle_a, []) == "handle_a")
+    
+    # Reloading a mod drops only the handles into that mod
+    assert(bridge.reload_mod("handle_a"))
+    assert(not bridge.is_handle_valid(handle_a))
+    assert(bridge.is_handle_valid(handle_b))
+    assert(bridge.call_handle(handle_b, []) == "handle_b")
+    
+    bridge.unload()
+
 func _process(delta):
     # Call update hook every frame
     LuaBridgeManager.call_lua_function("on_update", [delta])